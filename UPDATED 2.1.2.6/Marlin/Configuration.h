@@ -3189,6 +3189,7 @@
 
 #if ENABLED(TFT_COLOR_UI)
   //#define TFT_SHARED_IO    // SPI is shared between TFT display and other devices. Disable async data transfer
+  //#define TFT_DOUBLE_BUFFER // Draw the next part of the screen while DMA sends the last one. Splits TFT_BUFFER_WORDS in two.
 #endif
 
 #if ENABLED(TFT_LVGL_UI)
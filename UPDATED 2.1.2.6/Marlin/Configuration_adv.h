@@ -728,6 +728,15 @@
 // enable this option. Override at any time with M120, M121.
 //#define ENDSTOPS_ALWAYS_ON_DEFAULT
 
+/**
+ * Endstop Input Capture (STM32F1)
+ * Timestamp endstop and probe edges with the stepper timer in the endstop
+ * interrupt. The position at the trigger is then worked out from the block's
+ * step timing to a fraction of a step, for homing, probing and M119 / M114 D
+ * reports. Requires ENDSTOP_INTERRUPTS_FEATURE.
+ */
+//#define ENDSTOP_INPUT_CAPTURE
+
 // @section extras
 
 //#define Z_LATE_ENABLE // Enable Z the last moment. Needed if your Z driver overheats.
@@ -883,6 +892,23 @@
 #define HOMING_BUMP_DIVISOR { 6, 6, 8 }       // Re-Bump Speed Divisor (Divides the Homing Feedrate)
 
 //#define HOMING_BACKOFF_POST_MM { 2, 2, 2 }  // (linear=mm, rotational=°) Backoff from endstops after homing
+
+/**
+ * Adaptive Homing
+ * Learn how far past the bump trigger point the fast homing move stops.
+ * Once the history is consistent and the axis position is still trusted,
+ * G28 travels faster than the homing feedrate to near the switch, homes from
+ * there, and skips the bump if the fast hit lands where the history expects it.
+ * Any deviation falls back to the full bump cycle and restarts the learning.
+ * Save the history with M500. Clear it with M216 C.
+ */
+//#define ADAPTIVE_HOMING
+#if ENABLED(ADAPTIVE_HOMING)
+  #define ADAPTIVE_HOMING_TOLERANCE   0.02  // (mm) Largest deviation of the fast hit to skip the bump
+  #define ADAPTIVE_HOMING_SAMPLES        3  // Consistent bump cycles needed before skipping the bump
+  #define ADAPTIVE_HOMING_APPROACH_MM    5  // (mm) Distance from the switch to start the homing move
+  #define ADAPTIVE_HOMING_SPEEDUP        2  // Travel to the approach point at this multiple of the homing feedrate (1-4)
+#endif
 //#define XY_COUNTERPART_BACKOFF_MM 0         // (mm) Backoff X after homing Y, and vice-versa
 
 #define QUICK_HOME                          // If G28 contains XY do a diagonal move first
@@ -1058,6 +1084,20 @@
 
 #endif
 
+/**
+ * Robust Least-Squares Fit
+ * Reject probe outliers (e.g., a spike from debris or a bad trigger) with a
+ * RANSAC pass before fitting the bed plane, and report the fit residuals.
+ * Used by G29 (AUTO_BED_LEVELING_LINEAR), G34 (Z_STEPPER_ALIGN_STEPPER_XY) and G35.
+ * Outliers can only be identified with 5 or more probe points.
+ */
+//#define LSF_ROBUST_FIT
+#if ENABLED(LSF_ROBUST_FIT)
+  #define LSF_OUTLIER_THRESHOLD  0.1    // (mm) Points farther than this from the trial plane are rejected
+  #define LSF_RANSAC_ITERATIONS   24    // Number of 3-point trial planes to evaluate
+  //#define LSF_QUADRATIC_REPORT        // Also fit a quadratic surface to report bed bow (G29 V3)
+#endif
+
 // @section motion control
 
 /**
@@ -1095,6 +1135,55 @@
   //#define SHAPING_MIN_FREQ  20.0      // (Hz) By default the minimum of the shaping frequencies. Override to affect SRAM usage.
   //#define SHAPING_MAX_STEPRATE 10000  // By default the maximum total step rate of the shaped axes. Override to affect SRAM usage.
   //#define SHAPING_MENU                // Add a menu to the LCD to set shaping parameters.
+
+  /**
+   * Higher order shapers, selected per axis with M593 T. They cancel ringing over a wider
+   * band of frequencies than ZV at the cost of some extra smoothing. The echo queue grows
+   * to hold the longest (1.5 period) delay so expect around 3x the SRAM of the ZV shaper.
+   *   0:ZV  1:ZVD  2:MZV  3:EI  4:2HUMP_EI
+   */
+  //#define SHAPING_MULTI_IMPULSE
+  #if ENABLED(SHAPING_MULTI_IMPULSE)
+    #define SHAPING_TYPE_X 2            // Default shaper type for the X axis
+    #define SHAPING_TYPE_Y 2            // Default shaper type for the Y axis
+  #endif
+
+  /**
+   * Shape the speed trapezoid of each block instead of echoing every X/Y step.
+   * The block's velocity profile is convolved with the shaper impulses before
+   * step generation, so shaped axes cost no extra stepper interrupts and the
+   * step rate ceiling is unchanged. Blocks moving both X and Y use the X and Y
+   * shapers combined. Speed changes between blocks (jerk / junction deviation)
+   * are not shaped, so keep those low.
+   * Every step interrupt of a shaped block sums the shaper impulses: 2 (ZV,
+   * one axis) to 16 (SHAPING_MULTI_IMPULSE, X and Y), each one or two 32x32->64
+   * bit multiplies. That is one UMULL on ARM but a library call on AVR, so
+   * a 32-bit board is required.
+   */
+  //#define SHAPING_TRAPEZOID
+
+  /**
+   * Resonance test with M593 A [X|Y] [S]. Shake the axis through a frequency sweep,
+   * find the resonant peaks with an accelerometer on the toolhead (X) or bed (Y)
+   * and recommend shaper settings. S applies them.
+   */
+  //#define SHAPING_AUTOTUNE
+  #if ENABLED(SHAPING_AUTOTUNE)
+    #define SHAPING_AUTOTUNE_FREQ_MIN      10   // (Hz) Start of the sweep
+    #define SHAPING_AUTOTUNE_FREQ_MAX     120   // (Hz) End of the sweep
+    #define SHAPING_AUTOTUNE_HZ_PER_SEC     1   // (Hz/s) Rate of the sweep. Slower finds sharper peaks.
+    #define SHAPING_AUTOTUNE_ACCEL_PER_HZ  60   // (mm/s^2 per Hz) Excitation acceleration
+    #define SHAPING_AUTOTUNE_FFT_SIZE     256   // Samples per FFT (64, 128, 256, 512). Uses 10 bytes of SRAM per sample.
+
+    #define SHAPING_ACCEL_ADXL345               // ADXL345 on the I2C bus
+    #define ADXL345_I2C_ADDRESS          0x53   // 0x1D with SDO high
+    //#define SHAPING_ACCEL_SIMULATED           // A simulated sensor for testing without hardware
+    #if ENABLED(SHAPING_ACCEL_SIMULATED)
+      #define SHAPING_SIM_FREQ_X  42.0          // (Hz) Resonance of the simulated X axis
+      #define SHAPING_SIM_FREQ_Y  35.0          // (Hz) Resonance of the simulated Y axis
+      #define SHAPING_SIM_ZETA     0.08         // Damping ratio of the simulated axes
+    #endif
+  #endif
 #endif
 
 // @section motion
@@ -1145,6 +1234,19 @@
 #define SLOWDOWN
 #if ENABLED(SLOWDOWN)
   #define SLOWDOWN_DIVISOR 2
+
+  /**
+   * Adaptive slowdown
+   * Instead of the divisor rule, measure how fast moves arrive from the host or
+   * SD card and how much motion is queued. When the queue is predicted to run dry,
+   * stretch new moves smoothly so the printer slows down instead of stopping.
+   * With MOTION_TELEMETRY each slowed move is reported.
+   */
+  //#define SLOWDOWN_ADAPTIVE
+  #if ENABLED(SLOWDOWN_ADAPTIVE)
+    #define SLOWDOWN_RESERVE_MS   200   // (ms) Queued motion to keep in reserve
+    #define SLOWDOWN_MIN_FACTOR   0.3   // Don't slow moves below this fraction of their feedrate
+  #endif
 #endif
 
 /**
@@ -1548,6 +1650,68 @@
   // Since the FAT gets out of order with usage, SDCARD_SORT_ALPHA is recommended.
   #define SDCARD_RATHERRECENTFIRST
 
+  // Keep the cluster chain of the file being printed as a short list of
+  // contiguous runs, and give the FAT its own 512-byte cache, so reading
+  // the file doesn't go back to the FAT at every cluster boundary.
+  //#define SD_EXTENT_CACHE
+  #if ENABLED(SD_EXTENT_CACHE)
+    #define SD_EXTENT_COUNT 16              // (1-255) Runs to keep. Costs 8 bytes each.
+  #endif
+
+  // Keep a multi-block read (CMD18) open while the file is read in order,
+  // so each 512-byte block costs no command and response. Any seek, write
+  // or other command ends it and reading falls back to single blocks.
+  //#define SD_STREAM_READS
+
+  // Buffer lines saved with M28 or logged with M928 and write them from idle()
+  // in whole blocks, with multi-block writes and clusters allocated ahead,
+  // instead of a card write for every line.
+  //#define SD_WRITE_BEHIND
+  #if ENABLED(SD_WRITE_BEHIND)
+    #define SD_WRITE_BEHIND_BLOCKS 4        // (2-16) Buffer size in 512-byte blocks
+    #define SD_WRITE_PREALLOCATE   4        // (1-64) Clusters to allocate at once for a growing file
+  #endif
+
+  // For the linux_native build. Use a FAT16/FAT32 disk image file as the SD card,
+  // with delays to act like a real card. With MARLIN_TEST_BUILD the SD code is
+  // benchmarked at startup, reporting bytes/s and card commands for each test.
+  // Make an image with: mkfs.vfat -C -F 32 sdcard.img 262144
+  //#define SD_IMAGE_DRIVER
+  #if ENABLED(SD_IMAGE_DRIVER)
+    #define SD_IMAGE_PATH      "sdcard.img" // Image file, opened read/write
+    #define SD_IMAGE_COMMAND_US 0           // (µs) Delay for every card command
+    #define SD_IMAGE_BLOCK_US   0           // (µs) Delay for every 512-byte block read or written
+  #endif
+
+  // Scan the file being printed in the background for layer change comments
+  // and M486 objects. 'M26 L<layer>' goes straight to a layer, and with
+  // CANCEL_OBJECTS a canceled object with only moves is skipped without reading.
+  // The scan reads a block only while the print has a full command queue.
+  // Each of its reads ends an SD_STREAM_READS multi-block read, which the print
+  // opens again on its next blocks. Uses 512 bytes plus the tables below.
+  //#define SD_GCODE_INDEX
+  #if ENABLED(SD_GCODE_INDEX)
+    #define SD_GCODE_INDEX_LAYERS  200      // (16-10000) Layers to index. Costs 12 bytes each.
+    #define SD_GCODE_INDEX_OBJECTS  32      // (8-1000) M486 object starts to index ahead of the print. Costs 12 bytes each.
+  #endif
+
+  // Scan the file being printed in the background for its layer count, filament
+  // use, and print time from the planner limits. Progress and time left come from
+  // the estimate, corrected by the actual print speed. 'M27 E' reports it, and
+  // M73 and M78 (PRINTCOUNTER) include it in their reports.
+  //#define SD_JOB_ESTIMATE
+  #if ENABLED(SD_JOB_ESTIMATE)
+    #define SD_JOB_ESTIMATE_REGIONS 50      // (10-250) Parts of the file with their own time and max feedrate. Costs 6 bytes each.
+  #endif
+
+  // Keep the location of each item in the working directory so that
+  // selecting a file by index (media menu, sorting, print button) seeks
+  // straight to it instead of reading the directory from the start.
+  //#define SD_DIR_INDEX
+  #if ENABLED(SD_DIR_INDEX)
+    #define SD_DIR_INDEX_SIZE 64            // (8-1024) Items to index. Costs 2 bytes each.
+  #endif
+
   #define SD_MENU_CONFIRM_START             // Confirm the selected SD file before printing
 
   //#define NO_SD_AUTOSTART                 // Remove auto#.g file support completely to save some Flash, SRAM
@@ -1587,6 +1751,14 @@
     // especially with "vase mode" printing. Set too high and vases cannot be continued.
     #define POWER_LOSS_MIN_Z_CHANGE 0.05 // (mm) Minimum Z change before saving power-loss data
 
+    // Keep the recovery file as a pre-allocated journal. Each save is one block write,
+    // usually a small record of position, SD position and feedrate. The full state is
+    // only written again when something else (temperatures, fans, etc.) has changed.
+    //#define POWER_LOSS_JOURNAL
+    #if ENABLED(POWER_LOSS_JOURNAL)
+      #define POWER_LOSS_JOURNAL_BLOCKS 32 // (8-255) Journal size in 512-byte blocks
+    #endif
+
     // Enable if Z homing is needed for proper recovery. 99.9% of the time this should be disabled!
     //#define POWER_LOSS_RECOVER_ZHOME
     #if ENABLED(POWER_LOSS_RECOVER_ZHOME)
@@ -1639,6 +1811,14 @@
   #define LONG_FILENAME_HOST_SUPPORT      // Get the long filename of a file/folder with 'M33 <dosname>' and list long filenames with 'M20 L'
   //#define LONG_FILENAME_WRITE_SUPPORT   // Create / delete files with long filenames via M28, M30, and Binary Transfer Protocol
   //#define M20_TIMESTAMP_SUPPORT         // Include timestamps by adding the 'T' flag to M20 commands
+  //#define M20_PAGINATION                // List part of the files with 'M20 R<first> C<count>' so a big card doesn't stall the printer
+
+  // Keep the root folder listing for M20 in RAM, with long filenames, sizes and dates,
+  // so hosts can list it without reading the card. Writing to the card clears it.
+  //#define SD_LISTING_CACHE
+  #if ENABLED(SD_LISTING_CACHE)
+    #define SD_LISTING_CACHE_SIZE 2048    // (256-16384) Bytes of RAM. Each item costs about 24 bytes plus its long filename.
+  #endif
 
   //#define SCROLL_LONG_FILENAMES         // Scroll long filenames in the SD card menu
 
@@ -1819,6 +1999,17 @@
     // The normal delay is 10µs. Use the lowest value that still gives a reliable display.
     //#define DOGM_SPI_DELAY_US 5
 
+    /**
+     * Send only the rows (and parts of rows) that changed since the last frame.
+     * Keeps a copy of the display RAM (1K of SRAM) and resends one row in full
+     * per frame to clear glitches. The screen update takes much less time away
+     * from the planner while printing. Frame times are reported by CPU_PROFILER.
+     */
+    //#define ST7920_DIFF_REFRESH
+    #if ENABLED(ST7920_DIFF_REFRESH)
+      #define ST7920_DIFF_BUDGET_MS 5   // (ms) Draw more pages in one update while within this time
+    #endif
+
     //#define LIGHTWEIGHT_UI
     #if ENABLED(LIGHTWEIGHT_UI)
       #define STATUS_EXPIRE_SECONDS 20
@@ -2067,6 +2258,9 @@
 //#define BABYSTEPPING
 #if ENABLED(BABYSTEPPING)
   //#define INTEGRATED_BABYSTEPPING         // EXPERIMENTAL integration of babystepping into the Stepper ISR
+  #if ENABLED(INTEGRATED_BABYSTEPPING)
+    //#define BABYSTEP_SMOOTH               // Send Z babysteps with the step pulses of moves without Z, instead of pausing them
+  #endif
   //#define BABYSTEP_WITHOUT_HOMING
   //#define BABYSTEP_ALWAYS_AVAILABLE       // Allow babystepping at all times (not just during movement)
   //#define BABYSTEP_XY                     // Also enable X/Y Babystepping. Not supported on DELTA!
@@ -2122,6 +2316,17 @@
   //#define LA_DEBUG              // Print debug information to serial during operation. Disable for production use.
   #define ALLOW_LOW_EJERK       // Allow a DEFAULT_EJERK value of <10. Recommended for direct drive hotends.
   //#define EXPERIMENTAL_I2S_LA   // Allow I2S_STEPPER_STREAM to be used with LA. Performance degrades as the LA step rate reaches ~20kHz.
+
+  /**
+   * Smooth the advance over a window of time instead of switching it on and off with
+   * the acceleration. The extruder speed then ramps through each change of acceleration
+   * within a block, which is easier on the E stepper at high speed (e.g., with
+   * S_CURVE_ACCELERATION). Changes of acceleration at block junctions are not smoothed.
+   */
+  //#define SMOOTH_LIN_ADVANCE
+  #if ENABLED(SMOOTH_LIN_ADVANCE)
+    #define LIN_ADVANCE_SMOOTH_TIME 0.04  // (s) Width of the smoothing window. Longer is smoother but the pressure lags more.
+  #endif
 #endif
 
 // @section leveling
@@ -2334,6 +2539,20 @@
 // Moves (or segments) with fewer steps than this will be joined with the next move
 #define MIN_STEPS_PER_SEGMENT 6
 
+/**
+ * Inverse Kinematics Extrapolation
+ * For DELTA, SCARA, TPARA and POLARGRAPH, get the joint positions of the inner
+ * segments of a move by extrapolating from the previous segments, instead of doing
+ * the full inverse kinematics (square roots and trig) for every segment.
+ * Allows a higher DEFAULT_SEGMENTS_PER_SECOND on slower boards.
+ * Enable MARLIN_TEST_BUILD to report the error against the full solve at startup.
+ */
+//#define IK_EXTRAPOLATION
+#if ENABLED(IK_EXTRAPOLATION)
+  #define IK_EXACT_INTERVAL          16    // Do a full solve at least every N segments (DELTA: 2-32, others: 6-32)
+  #define IK_EXTRAPOLATION_TOLERANCE 0.002 // (mm or °) Do full solves more often to keep the error under this
+#endif
+
 /**
  * Minimum delay before and after setting the stepper DIR (in ns)
  *     0 : No delay (Expect at least 10µS since one Stepper ISR must transpire)
@@ -2451,6 +2670,17 @@
  */
 #define EMERGENCY_PARSER
 
+/**
+ * Out-of-band Commands
+ *
+ * Answer status commands from the host while a long command like G28, G29,
+ * M109, M190, M400 or M600 is still waiting, instead of after it finishes.
+ * The command is taken out of the queue and run from idle().
+ * Currently handles M27, M31, M105, M114 (and M108, M112, M410 without
+ * the EMERGENCY_PARSER).
+ */
+//#define OUT_OF_BAND_COMMANDS
+
 /**
  * Realtime Reporting (requires EMERGENCY_PARSER)
  *
@@ -3903,6 +4133,7 @@
 //#define CANCEL_OBJECTS
 #if ENABLED(CANCEL_OBJECTS)
   #define CANCEL_OBJECTS_REPORTING // Emit the current object as a status message
+  //#define CANCEL_OBJECTS_SD_SKIP   // Skip the lines of a canceled object as they're read from the SD card
 #endif
 
 /**
@@ -4273,6 +4504,28 @@
    * To help diagnose print quality issues stemming from empty command buffers.
    */
   //#define BUFFER_MONITORING
+
+  /**
+   * D8 - CPU Profiler
+   * Count calls and min / avg / max cycles of Stepper::isr, Temperature::isr,
+   * idle(), ui.update(), manage_inactivity(), queue.advance() and graphical
+   * LCD frames, with each one's share of the CPU. Use it to see which features
+   * cost the most time.
+   * Requires a Cortex-M3/M4/M7 (DWT cycle counter) or linux_native.
+   */
+  //#define CPU_PROFILER
+#endif
+
+/**
+ * M577 - Motion Telemetry
+ * Stream a binary record of each block the stepper runs (start and end rates,
+ * planner fill, ISR overruns) and each time it runs out of blocks. Use it to
+ * find where and why a print stutters. The records share the serial port with
+ * the usual replies, so decode them with buildroot/share/scripts/telemetry_decode.py.
+ */
+//#define MOTION_TELEMETRY
+#if ENABLED(MOTION_TELEMETRY)
+  #define MOTION_TELEMETRY_RECORDS 32   // Ring buffer size (power of 2). Records beyond this are dropped and counted.
 #endif
 
 /**
@@ -48,8 +48,15 @@
 
 #include "../../module/endstops.h"
 
+#if ENABLED(ENDSTOP_INPUT_CAPTURE)
+  #include "../../module/stepper.h"
+#endif
+
 // One ISR for all EXT-Interrupts
-void endstop_ISR() { endstops.update(); }
+void endstop_ISR() {
+  // The step timer restarts from 0 on every Stepper ISR, so its count dates the edge
+  TERN(ENDSTOP_INPUT_CAPTURE, stepper.capture_endstop_edge(HAL_timer_get_count(MF_TIMER_STEP)), endstops.update());
+}
 
 void setup_endstop_interrupts() {
   #define _ATTACH(P) attachInterrupt(P, endstop_ISR, CHANGE)
@@ -190,6 +190,10 @@
   #include "feature/cancel_object.h"
 #endif
 
+#if HAS_GCODE_SCAN
+  #include "feature/gcode_index.h"
+#endif
+
 #if HAS_FILAMENT_SENSOR
   #include "feature/runout.h"
 #endif
@@ -252,6 +256,18 @@
   #include "feature/easythreed_ui.h"
 #endif
 
+#if ENABLED(SHAPING_AUTOTUNE)
+  #include "feature/resonance_test.h"
+#endif
+
+#if ENABLED(MOTION_TELEMETRY)
+  #include "feature/motion_telemetry.h"
+#endif
+
+#if ENABLED(CPU_PROFILER)
+  #include "feature/cpu_profiler.h"
+#endif
+
 #if ENABLED(MARLIN_TEST_BUILD)
   #include "tests/marlin_tests.h"
 #endif
@@ -406,6 +422,7 @@ void startOrResumeJob() {
  *  - Pulse FET_SAFETY_PIN if it exists
  */
 inline void manage_inactivity(const bool no_stepper_sleep=false) {
+  TERN_(CPU_PROFILER, PROFILE_SCOPE(INACTIVITY));
 
   queue.get_available_commands();
 
@@ -767,6 +784,7 @@ inline void manage_inactivity(const bool no_stepper_sleep=false) {
  *  - Handle SD Card insert / remove
  *  - Handle USB Flash Drive insert / remove
  *  - Announce Host Keepalive state (if any)
+ *  - Run out-of-band status commands
  *  - Update the Print Job Timer state
  *  - Update the Beeper queue
  *  - Read Buttons and Update the LCD
@@ -779,6 +797,7 @@ void idle(const bool no_stepper_sleep/*=false*/) {
   #ifdef MAX7219_DEBUG_PROFILE
     CodeProfiler idle_profiler;
   #endif
+  TERN_(CPU_PROFILER, PROFILE_SCOPE(IDLE));
 
   #if ENABLED(MARLIN_DEV_MODE)
     static uint16_t idle_depth = 0;
@@ -829,12 +848,21 @@ void idle(const bool no_stepper_sleep/*=false*/) {
   // Handle SD Card insert / remove
   TERN_(HAS_MEDIA, card.manage_media());
 
+  // Write buffered M28 / M928 lines to the file
+  TERN_(SD_WRITE_BEHIND, card.write_behind());
+
+  // Index layers and objects and estimate the print time ahead of the print
+  TERN_(HAS_GCODE_SCAN, gcode_index.task());
+
   // Handle USB Flash Drive insert / remove
   TERN_(USB_FLASH_DRIVE_SUPPORT, card.diskIODriver()->idle());
 
   // Announce Host Keepalive state (if any)
   TERN_(HOST_KEEPALIVE_FEATURE, gcode.host_keepalive());
 
+  // Answer status commands sent while a command handler waits
+  TERN_(OUT_OF_BAND_COMMANDS, queue.process_out_of_band());
+
   // Update the Print Job Timer state
   TERN_(PRINTCOUNTER, print_job_timer.tick());
 
@@ -844,6 +872,12 @@ void idle(const bool no_stepper_sleep/*=false*/) {
   // Handle UI input / draw events
   TERN(DWIN_CREALITY_LCD, DWIN_Update(), ui.update());
 
+  // Gather accelerometer samples for M593 A
+  TERN_(SHAPING_AUTOTUNE, resonance_test.idle());
+
+  // Send motion telemetry records for M577
+  TERN_(MOTION_TELEMETRY, motion_telemetry.stream());
+
   // Run i2c Position Encoders
   #if ENABLED(I2C_POSITION_ENCODERS)
   {
@@ -866,6 +900,7 @@ void idle(const bool no_stepper_sleep/*=false*/) {
       TERN_(AUTO_REPORT_SD_STATUS, card.auto_reporter.tick());
       TERN_(AUTO_REPORT_POSITION, position_auto_reporter.tick());
       TERN_(BUFFER_MONITORING, queue.auto_report_buffer_statistics());
+      TERN_(CPU_PROFILER, cpu_profiler.auto_reporter.tick());
     }
   #endif
 
@@ -0,0 +1,169 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2024 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * accelerometer.cpp - Acceleration sensors for the resonance test
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(SHAPING_AUTOTUNE)
+
+#include "accelerometer.h"
+
+#if ENABLED(SHAPING_ACCEL_ADXL345)
+
+#include <Wire.h>
+
+#define ADXL345_DEVID        0x00
+#define ADXL345_BW_RATE      0x2C
+#define ADXL345_POWER_CTL    0x2D
+#define ADXL345_DATA_FORMAT  0x31
+#define ADXL345_DATAX0       0x32
+#define ADXL345_FIFO_CTL     0x38
+#define ADXL345_FIFO_STATUS  0x39
+
+static void adxl_write(const uint8_t reg, const uint8_t val) {
+  Wire.beginTransmission(uint8_t(ADXL345_I2C_ADDRESS));
+  Wire.write(reg);
+  Wire.write(val);
+  Wire.endTransmission();
+}
+
+static bool adxl_read(const uint8_t reg, uint8_t * const buf, const uint8_t len) {
+  Wire.beginTransmission(uint8_t(ADXL345_I2C_ADDRESS));
+  Wire.write(reg);
+  if (Wire.endTransmission(false)) return false;
+  if (Wire.requestFrom(uint8_t(ADXL345_I2C_ADDRESS), len) != len) return false;
+  for (uint8_t i = 0; i < len; ++i) buf[i] = Wire.read();
+  return true;
+}
+
+bool ADXL345::begin() {
+  #if PINS_EXIST(I2C_SCL, I2C_SDA) && DISABLED(SOFT_I2C_EEPROM)
+    Wire.setSDA(pin_t(I2C_SDA_PIN));
+    Wire.setSCL(pin_t(I2C_SCL_PIN));
+  #endif
+  Wire.begin();
+
+  uint8_t id;
+  if (!adxl_read(ADXL345_DEVID, &id, 1) || id != 0xE5) return false;
+
+  adxl_write(ADXL345_POWER_CTL, 0x00);    // Standby while configuring
+  adxl_write(ADXL345_DATA_FORMAT, 0x0B);  // Full resolution, ±16g
+  adxl_write(ADXL345_BW_RATE, 0x0C);      // 400Hz output data rate
+  adxl_write(ADXL345_FIFO_CTL, 0x00);     // Bypass mode to empty the FIFO...
+  adxl_write(ADXL345_FIFO_CTL, 0x80);     // ...then stream mode
+  adxl_write(ADXL345_POWER_CTL, 0x08);    // Measure
+  return true;
+}
+
+void ADXL345::end() { adxl_write(ADXL345_POWER_CTL, 0x00); }
+
+uint8_t ADXL345::read(xyz_int_t samples[], const uint8_t max) {
+  uint8_t status;
+  if (!adxl_read(ADXL345_FIFO_STATUS, &status, 1)) return 0;
+  const uint8_t count = _MIN(status & 0x3F, max);
+  for (uint8_t n = 0; n < count; ++n) {
+    uint8_t d[6];   // Each read of the data registers pops one FIFO entry
+    if (!adxl_read(ADXL345_DATAX0, d, 6)) return n;
+    samples[n].set(int16_t(d[0] | (d[1] << 8)), int16_t(d[2] | (d[3] << 8)), int16_t(d[4] | (d[5] << 8)));
+  }
+  return count;
+}
+
+#elif ENABLED(SHAPING_ACCEL_SIMULATED)
+
+#include "../module/planner.h"
+
+millis_t SimulatedAccelerometer::start_ms, SimulatedAccelerometer::poll_ms;
+uint32_t SimulatedAccelerometer::sample_count;
+xy_pos_t SimulatedAccelerometer::poll_pos,
+         SimulatedAccelerometer::prev[2],
+         SimulatedAccelerometer::spring,
+         SimulatedAccelerometer::spring_v;
+
+xy_pos_t SimulatedAccelerometer::stepper_pos() {
+  return { planner.get_axis_position_mm(X_AXIS), planner.get_axis_position_mm(Y_AXIS) };
+}
+
+bool SimulatedAccelerometer::begin() {
+  start_ms = poll_ms = millis();
+  sample_count = 0;
+  poll_pos = prev[0] = prev[1] = stepper_pos();
+  spring.reset();
+  spring_v.reset();
+  return true;
+}
+
+uint8_t SimulatedAccelerometer::read(xyz_int_t samples[], const uint8_t max) {
+  constexpr uint8_t substeps = 10;
+  constexpr float dt = 1.0f / (sample_rate * substeps),
+                  counts_per_mm_s2 = ACCEL_COUNTS_PER_G / 9806.65f;
+  constexpr xy_float_t omega = { float(M_PI) * 2 * (SHAPING_SIM_FREQ_X), float(M_PI) * 2 * (SHAPING_SIM_FREQ_Y) };
+  static uint16_t noise = 1;
+
+  const millis_t now = millis();
+  const xy_pos_t pos = stepper_pos();
+  const uint32_t due = (now - start_ms) * sample_rate / 1000UL;
+
+  uint8_t n = 0;
+  for (; n < max && sample_count < due; ++n) {
+    // Carriage position at the sample time, between the last two reads
+    const float t_ms = float(sample_count++) * 1000 / sample_rate,
+                f = now == poll_ms ? 1.0f : (t_ms - (poll_ms - start_ms)) / (now - poll_ms);
+    const xy_pos_t p = poll_pos + (pos - poll_pos) * f,
+                   accel = (p - prev[0] * 2 + prev[1]) * sq(float(sample_rate));
+    prev[1] = prev[0];
+    prev[0] = p;
+
+    // Toolhead acceleration relative to the frame is -2ζωv - ω²x for spring offset x
+    xy_float_t out;
+    for (uint8_t a = 0; a < 2; ++a) {
+      float &x = spring[a], &v = spring_v[a];
+      const float w = omega[a], c = 2 * (SHAPING_SIM_ZETA) * w;
+      for (uint8_t s = 0; s < substeps; ++s) {
+        v += (-accel[a] - c * v - sq(w) * x) * dt;
+        x += v * dt;
+      }
+      out[a] = (-c * v - sq(w) * x) * counts_per_mm_s2;
+    }
+
+    // A little sensor noise
+    noise = noise * 25173 + 13849;
+    const int16_t jitter = (noise >> 13) - 4;
+    samples[n].set(
+      int16_t(constrain(out.x, -32767, 32767)) + jitter,
+      int16_t(constrain(out.y, -32767, 32767)) - jitter,
+      ACCEL_COUNTS_PER_G + jitter
+    );
+  }
+
+  // Interpolate from here next time, unless there are samples still to catch up
+  if (sample_count >= due) { poll_ms = now; poll_pos = pos; }
+
+  return n;
+}
+
+#endif // SHAPING_ACCEL_SIMULATED
+
+#endif // SHAPING_AUTOTUNE
@@ -0,0 +1,79 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2024 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * accelerometer.h - Acceleration sensors for the resonance test (M593 A)
+ *
+ * Every sensor has the same static interface so the test doesn't care which is fitted:
+ *   sample_rate  Output data rate (Hz)
+ *   begin()      Set up the sensor and start sampling. Return false if it doesn't answer.
+ *   end()        Stop sampling.
+ *   read()       Fetch up to 'max' buffered samples, oldest first. Return the number read.
+ * Samples are in sensor counts of ACCEL_COUNTS_PER_G.
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(SHAPING_ACCEL_ADXL345)
+
+  #define ACCEL_COUNTS_PER_G 256  // Full resolution, 3.9mg / LSB
+
+  class ADXL345 {
+    public:
+      static constexpr uint16_t sample_rate = 400;
+      static bool begin();
+      static void end();
+      static uint8_t read(xyz_int_t samples[], const uint8_t max);
+  };
+
+  typedef ADXL345 Accelerometer;
+
+#elif ENABLED(SHAPING_ACCEL_SIMULATED)
+
+  #define ACCEL_COUNTS_PER_G 256
+
+  /**
+   * A sensor for testing without hardware (e.g., on linux_native).
+   * The toolhead hangs on a damped spring on each of X and Y, driven by the
+   * stepper positions. The sensor reports the acceleration of the toolhead.
+   */
+  class SimulatedAccelerometer {
+    public:
+      static constexpr uint16_t sample_rate = 400;
+      static bool begin();
+      static void end() {}
+      static uint8_t read(xyz_int_t samples[], const uint8_t max);
+
+    private:
+      static millis_t start_ms, poll_ms;
+      static uint32_t sample_count;
+      static xy_pos_t poll_pos,   // Stepper position at the last read
+                      prev[2],    // Positions at the last two samples
+                      spring,     // Toolhead displacement from the carriage
+                      spring_v;   // ...and its rate of change
+      static xy_pos_t stepper_pos();
+  };
+
+  typedef SimulatedAccelerometer Accelerometer;
+
+#endif
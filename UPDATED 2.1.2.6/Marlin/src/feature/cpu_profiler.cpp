@@ -0,0 +1,80 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2024 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * cpu_profiler.cpp - Cycle counts for the stepper and temperature ISRs and the idle() tasks
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(CPU_PROFILER)
+
+#include "cpu_profiler.h"
+
+CPUProfiler cpu_profiler;
+
+profile_stats_t CPUProfiler::stats[PROFILE_SECTIONS];
+volatile uint32_t CPUProfiler::isr_cycles[PROFILE_TEMP_ISR + 1];
+millis_t CPUProfiler::start_ms;
+AutoReporter<CPUProfiler::AutoReport> CPUProfiler::auto_reporter;
+
+static PGM_P const section_names[PROFILE_SECTIONS] PROGMEM = {
+  PSTR("Stepper::isr"), PSTR("Temperature::isr"), PSTR("idle"),
+  PSTR("ui.update"), PSTR("manage_inactivity"), PSTR("queue.advance"), PSTR("ui.frame")
+};
+
+void CPUProfiler::reset() {
+  CRITICAL_SECTION_START();
+  for (uint8_t s = 0; s < PROFILE_SECTIONS; ++s) stats[s] = { 0, 0, 0, 0 };
+  start_ms = millis();
+  CRITICAL_SECTION_END();
+}
+
+/**
+ * Print one line per section with calls, min / avg / max cycles and the
+ * share of the CPU used since the last reset:
+ *   "Stepper::isr calls:12000 min:310 avg:420 max:1210 load:7.0%"
+ */
+void CPUProfiler::report(const bool do_reset/*=false*/) {
+  profile_stats_t copy[PROFILE_SECTIONS];
+  CRITICAL_SECTION_START();
+  COPY(copy, stats);
+  const millis_t window_ms = millis() - start_ms;
+  CRITICAL_SECTION_END();
+  if (do_reset) reset();
+
+  SERIAL_ECHOLNPGM("Profile ", window_ms, "ms @ ", PROFILER_CLOCK, TERN(__PLAT_LINUX__, "Hz (ns)", "Hz (cycles)"));
+  const float window_cycles = float(window_ms) * (PROFILER_CLOCK / 1000);
+  for (uint8_t s = 0; s < PROFILE_SECTIONS; ++s) {
+    const profile_stats_t &st = copy[s];
+    SERIAL_ECHOPGM_P((PGM_P)pgm_read_ptr(&section_names[s]));
+    SERIAL_ECHOPGM(" calls:", st.calls);
+    if (st.calls) {
+      SERIAL_ECHOPGM(" min:", st.min, " avg:", uint32_t(st.total / st.calls), " max:", st.max, " load:");
+      SERIAL_PRINT(window_cycles ? 100.0f * st.total / window_cycles : 0.0f, 1);
+      SERIAL_CHAR('%');
+    }
+    SERIAL_EOL();
+  }
+}
+
+#endif // CPU_PROFILER
@@ -0,0 +1,123 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2024 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * cpu_profiler.h - Cycle counts for the stepper and temperature ISRs and the idle() tasks
+ *
+ * Each profiled section counts its calls and its min / avg / max cycles.
+ * Profiled ISRs that interrupt a section are subtracted from it, so a section
+ * shows its own work plus any profiled sections nested inside it.
+ *
+ * On Cortex-M the cycles come from the DWT cycle counter, enabled at boot by
+ * calibrate_delay_loop(). On linux_native they are std::chrono nanoseconds.
+ */
+
+#include "../inc/MarlinConfig.h"
+#include "../libs/autoreport.h"
+
+#ifdef __PLAT_LINUX__
+  #include <chrono>
+  #define PROFILER_CLOCK 1000000000UL     // Nanoseconds
+#else
+  #define PROFILER_CLOCK F_CPU
+  #define PROFILER_DWT_CYCCNT (*(volatile uint32_t *)0xE0001004)
+#endif
+
+enum ProfileSection : uint8_t {
+  PROFILE_STEPPER_ISR,    // ISR sections first
+  PROFILE_TEMP_ISR,
+  PROFILE_IDLE,
+  PROFILE_UI_UPDATE,
+  PROFILE_INACTIVITY,
+  PROFILE_QUEUE_ADVANCE,
+  PROFILE_UI_FRAME,       // All the pages of a u8g screen, drawn over several calls
+  PROFILE_SECTIONS
+};
+
+typedef struct {
+  uint32_t calls, min, max;
+  uint64_t total;
+} profile_stats_t;
+
+class CPUProfiler {
+  public:
+    static profile_stats_t stats[PROFILE_SECTIONS];
+    static volatile uint32_t isr_cycles[PROFILE_TEMP_ISR + 1];  // Running total for each profiled ISR, only written by that ISR
+    static millis_t start_ms;             // Start of the reported window
+
+    FORCE_INLINE static uint32_t cycles() {
+      #ifdef __PLAT_LINUX__
+        return uint32_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+      #else
+        return PROFILER_DWT_CYCCNT;
+      #endif
+    }
+
+    // Total cycles of the profiled ISRs. The ISRs can interrupt each other, so each keeps its own count.
+    FORCE_INLINE static uint32_t isr_total() { return isr_cycles[PROFILE_STEPPER_ISR] + isr_cycles[PROFILE_TEMP_ISR]; }
+
+    // Add a call to a section, minus the ISR cycles that interrupted it
+    static void add(const ProfileSection s, const uint32_t elapsed, const uint32_t nested) {
+      const uint32_t own = nested < elapsed ? elapsed - nested : 0;
+      if (s <= PROFILE_TEMP_ISR) isr_cycles[s] += own;  // Subtract this from whatever it interrupted
+      profile_stats_t &st = stats[s];
+      if (!st.calls++ || own < st.min) st.min = own;
+      NOLESS(st.max, own);
+      st.total += own;
+    }
+
+    static void reset();
+    static void report(const bool do_reset=false);
+
+    struct AutoReport { static void report() { CPUProfiler::report(true); } };
+    static AutoReporter<AutoReport> auto_reporter;
+};
+
+extern CPUProfiler cpu_profiler;
+
+// Profile the rest of the enclosing block
+class ProfileScope {
+  const ProfileSection section;
+  const uint32_t start, isr_start;
+  public:
+    ProfileScope(const ProfileSection s) : section(s), start(CPUProfiler::cycles()), isr_start(CPUProfiler::isr_total()) {}
+    ~ProfileScope() {
+      // Read the ISR total first so an ISR in between can only add to this section
+      const uint32_t nested = CPUProfiler::isr_total() - isr_start;
+      CPUProfiler::add(section, CPUProfiler::cycles() - start, nested);
+    }
+};
+
+// Add the rest of the enclosing block to a total, for work spread over several calls
+class ProfileTally {
+  uint32_t &tally;
+  const uint32_t start, isr_start;
+  public:
+    ProfileTally(uint32_t &t) : tally(t), start(CPUProfiler::cycles()), isr_start(CPUProfiler::isr_total()) {}
+    ~ProfileTally() {
+      const uint32_t nested = CPUProfiler::isr_total() - isr_start, elapsed = CPUProfiler::cycles() - start;
+      if (nested < elapsed) tally += elapsed - nested;
+    }
+};
+
+#define PROFILE_SCOPE(S) const ProfileScope profile_scope(PROFILE_##S)
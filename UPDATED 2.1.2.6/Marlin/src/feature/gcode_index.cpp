@@ -0,0 +1,287 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2024 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * feature/gcode_index.cpp - Index of layers and M486 objects in the file being printed
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if HAS_GCODE_TRACKING
+
+#include "gcode_index.h"
+#include "../gcode/gcode.h"
+#include "../gcode/queue.h"
+#include "../module/motion.h"
+
+#if ENABLED(SD_JOB_ESTIMATE)
+  #include "job_estimate.h"
+#endif
+
+GcodeIndex gcode_index;
+
+/**
+ * Update the state for a whole line. Moves, comments, and the E mode and E position
+ * can be skipped by setting the state. Anything else has to run.
+ */
+TrackLine GcodeIndex::track(gcode_mark_t &s, const char *p) {
+  while (*p == ' ') ++p;
+  if (!*p) return TRACK_SKIP;
+
+  // Layer change comments from Cura, PrusaSlicer, Simplify3D and others
+  if (*p == ';') {
+    do ++p; while (*p == ' ');
+    return !strncasecmp_P(p, PSTR("LAYER_CHANGE"), 12)
+        || (!strncasecmp_P(p, PSTR("LAYER"), 5) && (p[5] == ':' || p[5] == ' ') && NUMERIC_SIGNED(p[6]))
+      ? TRACK_LAYER : TRACK_SKIP;
+  }
+
+  const char letter = *p++;
+  if (letter != 'G' && letter != 'M') return TRACK_RUN;
+  char *end;
+  const int code = strtol(p, &end, 10);
+  if (end == p || *end == '.') return TRACK_RUN;  // No code, or a subcode
+  p = end;
+
+  // Get a parameter value, stopping at a comment
+  float value;
+  auto seen = [&](const char c) {
+    for (const char *q = p; *q && *q != ';' && *q != '*'; ++q)
+      if (*q == c) { value = strtof(q + 1, nullptr); return true; }
+    return false;
+  };
+
+  if (letter == 'M') {
+    switch (code) {
+      case 82: s.e_relative = false; return TRACK_SKIP;
+      case 83: s.e_relative = true; return TRACK_SKIP;
+    }
+    return TRACK_RUN;
+  }
+
+  switch (code) {
+    case 0: case 1: case 2: case 3: case 5:
+      if (seen('E')) s.e = s.e_relative ? s.e + value : value;
+      if (seen('F') && value > 0) s.feedrate = uint16_t(value);
+      return TRACK_SKIP;
+    case 90: s.e_relative = false; break;  // Also sets the XYZ mode, so it has to run
+    case 91: s.e_relative = true; break;
+    case 92:
+      if (seen('E')) s.e = value;
+      if (!seen('X') && !seen('Y') && !seen('Z')) return TRACK_SKIP;
+      break;
+  }
+  return TRACK_RUN;
+}
+
+int8_t GcodeIndex::m486_object(const char *cmd) {
+  while (*cmd == ' ') ++cmd;
+  if (strncmp_P(cmd, PSTR("M486"), 4) || NUMERIC(cmd[4])) return -2;
+  for (cmd += 4; *cmd && *cmd != ';'; ++cmd)
+    if (*cmd == 'S') {
+      const int o = atoi(cmd + 1);
+      return WITHIN(o, -1, 31) ? int8_t(o) : -2;
+    }
+  return -2;
+}
+
+#if HAS_GCODE_SCAN
+
+bool GcodeIndex::complete; // = false
+
+MediaFile GcodeIndex::file;
+uint32_t GcodeIndex::first_cluster; // = 0
+gcode_mark_t GcodeIndex::state;
+uint8_t GcodeIndex::buffer[512];
+char GcodeIndex::line[MAX_CMD_SIZE];
+uint8_t GcodeIndex::line_len;
+
+static uint16_t buffer_len, buffer_pos;
+
+#define SCAN_INTERVAL_MS 2                        // Scan at most this often
+#define SCAN_LINES TERN(SD_JOB_ESTIMATE, 4, 16)   // Lines to scan each time. Timing the moves is the slow part.
+
+/**
+ * Start scanning the file that was just opened, from the start,
+ * with the machine state it will be printed with.
+ */
+void GcodeIndex::start() {
+  file = card.getFile();
+  first_cluster = file.firstCluster();
+  file.seekSet(0);
+  state.sdpos = 0;
+  state.e = current_position.e;
+  state.feedrate = uint16_t(MMS_TO_MMM(feedrate_mm_s));
+  state.object = -1;
+  state.e_relative = gcode.axis_is_relative(E_AXIS);
+  line_len = 0;
+  buffer_len = buffer_pos = 0;
+  complete = false;
+  TERN_(SD_GCODE_INDEX, layer_count = objects_used = 0);
+  TERN_(SD_JOB_ESTIMATE, job_estimate.start());
+}
+
+void GcodeIndex::reset() {
+  file.close();
+  first_cluster = 0;
+  TERN_(SD_JOB_ESTIMATE, job_estimate.reset());
+}
+
+/**
+ * Scan the line in the buffer, which starts at state.sdpos.
+ * Return false to scan it again later.
+ */
+bool GcodeIndex::scan_line() {
+  line[line_len] = '\0';
+
+  #if ENABLED(SD_GCODE_INDEX)
+    // Wait for the print to pass some objects if there's no room
+    const int8_t obj = m486_object(line);
+    if (obj >= -1 && !add_object(obj)) return false;
+  #endif
+
+  TERN_(SD_JOB_ESTIMATE, const float e_before = state.e);
+  const TrackLine t = track(state, line);
+
+  #if ENABLED(SD_GCODE_INDEX)
+    if (t == TRACK_LAYER) add_layer();
+    // A line that has to run keeps the reader from jumping over the object
+    else if (t == TRACK_RUN && obj < -1 && objects_used) objects[objects_used - 1].moves_only = false;
+  #endif
+
+  TERN_(SD_JOB_ESTIMATE, job_estimate.scan_line(line, state, state.e - e_before, t == TRACK_LAYER));
+
+  line_len = 0;
+  return true;
+}
+
+/**
+ * Scan the next few lines of the file being printed. Called from idle().
+ */
+void GcodeIndex::task() {
+  if (!IS_SD_FILE_OPEN() || card.flag.saving) {
+    if (first_cluster) reset();
+    return;
+  }
+  if (card.getFile().firstCluster() != first_cluster) start();
+
+  TERN_(SD_JOB_ESTIMATE, job_estimate.follow_print());
+
+  if (complete) return;
+
+  static millis_t next_scan_ms; // = 0
+  const millis_t ms = millis();
+  if (PENDING(ms, next_scan_ms)) return;
+  next_scan_ms = ms + SCAN_INTERVAL_MS;
+
+  for (uint8_t lines = SCAN_LINES; lines;) {
+    // Read a whole block straight into the buffer, leaving the volume cache to the printing.
+    // Leave the card to the printing until it has queued all the commands it can.
+    if (buffer_pos >= buffer_len) {
+      if (IS_SD_PRINTING() && !queue.ring_buffer.full()) return;
+      const int16_t n = file.read(buffer, sizeof(buffer));
+      if (n <= 0) {
+        if (line_len && !scan_line()) return;
+        complete = (n == 0);
+        TERN_(SD_JOB_ESTIMATE, if (complete) job_estimate.finish());
+        return;
+      }
+      buffer_len = n;
+      buffer_pos = 0;
+    }
+
+    const char c = buffer[buffer_pos];
+    if (c == '\n' || c == '\r') {
+      if (line_len) {
+        if (!scan_line()) return;
+        --lines;
+      }
+      state.sdpos = file.curPosition() - buffer_len + buffer_pos + 1;
+    }
+    else if (line_len < sizeof(line) - 1)
+      line[line_len++] = c;
+    ++buffer_pos;
+  }
+}
+
+#endif // HAS_GCODE_SCAN
+
+#if ENABLED(SD_GCODE_INDEX)
+
+uint16_t GcodeIndex::layer_count; // = 0
+
+gcode_mark_t GcodeIndex::layers[SD_GCODE_INDEX_LAYERS],
+             GcodeIndex::objects[SD_GCODE_INDEX_OBJECTS];
+uint16_t GcodeIndex::objects_used;
+
+// Add a mark for the layer change comment being scanned
+void GcodeIndex::add_layer() {
+  if (layer_count < SD_GCODE_INDEX_LAYERS) layers[layer_count] = state;
+  ++layer_count;
+}
+
+/**
+ * Add a mark for the M486 S line being scanned. When full, drop
+ * the marks already passed by the printing.
+ */
+bool GcodeIndex::add_object(const int8_t obj) {
+  if (objects_used >= SD_GCODE_INDEX_OBJECTS) {
+    uint16_t passed = 0;
+    while (passed < objects_used && objects[passed].sdpos < card.getIndex()) ++passed;
+    if (passed) --passed;   // Keep the object being printed
+    if (!passed) return false;
+    objects_used -= passed;
+    memmove(objects, &objects[passed], objects_used * sizeof(gcode_mark_t));
+  }
+  state.object = obj;
+  state.moves_only = true;
+  objects[objects_used++] = state;
+  return true;
+}
+
+// The mark for the M486 S line that ends at a file position
+const gcode_mark_t* GcodeIndex::object_start(const uint32_t sdpos) {
+  if (!first_cluster) return nullptr;
+  for (uint16_t i = objects_used; i--;)
+    if (objects[i].sdpos < sdpos) return &objects[i];
+  return nullptr;
+}
+
+// The next mark after an object mark, or null if not scanned yet
+const gcode_mark_t* GcodeIndex::next_mark(const gcode_mark_t * const m) {
+  const uint16_t i = m - objects + 1;
+  return i < objects_used ? &objects[i] : nullptr;
+}
+
+/**
+ * Set the state as it would be after printing up to a mark
+ */
+void GcodeIndex::apply(const gcode_mark_t &m) {
+  if (m.e_relative) gcode.set_e_relative(); else gcode.set_e_absolute();
+  current_position.e = m.e;
+  sync_plan_position_e();
+  feedrate_mm_s = MMM_TO_MMS(m.feedrate);
+}
+
+#endif // SD_GCODE_INDEX
+
+#endif // HAS_GCODE_TRACKING
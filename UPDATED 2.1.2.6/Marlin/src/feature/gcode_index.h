@@ -0,0 +1,113 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2024 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * feature/gcode_index.h - Index of layers and M486 objects in the file being printed
+ *
+ * The file is scanned in idle() through a second file handle, a few lines at a time,
+ * tracking the state that the G-code sets up (E position, feedrate, E mode) so that
+ * printing can continue from a layer or object start without reading up to it.
+ * The same scan feeds each line to the job estimate.
+ *
+ * The same tracking lets the SD reader skip the lines of a canceled object.
+ */
+
+#include "../inc/MarlinConfig.h"
+#include "../sd/cardreader.h"
+
+// The machine state set up by the file at the start of a line
+typedef struct {
+  uint32_t sdpos;       // File position of the line
+  float e;              // E position
+  uint16_t feedrate;    // (mm/min) Feedrate
+  int8_t object;        // Object started by M486 S on this line
+  bool e_relative:1;    // Relative E mode (M83 or G91)
+  bool moves_only:1;    // Up to the next object mark there are only lines that track() covers
+} gcode_mark_t;
+
+// What a line does, as far as track() is concerned
+enum TrackLine : uint8_t {
+  TRACK_RUN,            // The line has to run
+  TRACK_SKIP,           // A move, a comment, or a change to the tracked state
+  TRACK_LAYER           // A layer change comment
+};
+
+class GcodeIndex {
+  public:
+    // The object started by a "M486 S<n>" command, or -2 for other lines
+    static int8_t m486_object(const char *cmd);
+
+    // Update a state with a line of G-code and tell whether the line could be skipped
+    static TrackLine track(gcode_mark_t &s, const char *line);
+
+  #if HAS_GCODE_SCAN
+
+    static bool complete;           // The whole file has been scanned
+
+    static void reset();
+    static void task();
+
+    // File position of the line being scanned
+    static uint32_t scanned() { return state.sdpos; }
+
+  #endif
+
+  #if ENABLED(SD_GCODE_INDEX)
+
+    static uint16_t layer_count;    // Layers found so far
+
+    static const gcode_mark_t* layer(const uint16_t n) { return n < _MIN(layer_count, SD_GCODE_INDEX_LAYERS) ? &layers[n] : nullptr; }
+    static const gcode_mark_t* object_start(const uint32_t sdpos);
+    static const gcode_mark_t* next_mark(const gcode_mark_t * const m);
+    static void apply(const gcode_mark_t &m);
+
+  #endif
+
+  private:
+
+  #if HAS_GCODE_SCAN
+
+    static MediaFile file;          // Own handle on the file being printed
+    static uint32_t first_cluster;  // Identifies the file being scanned
+    static gcode_mark_t state;      // State at the start of the current line
+    static uint8_t buffer[512];
+    static char line[MAX_CMD_SIZE];
+    static uint8_t line_len;
+
+    static void start();
+    static bool scan_line();
+
+  #endif
+
+  #if ENABLED(SD_GCODE_INDEX)
+
+    static gcode_mark_t layers[SD_GCODE_INDEX_LAYERS], objects[SD_GCODE_INDEX_OBJECTS];
+    static uint16_t objects_used;
+
+    static void add_layer();
+    static bool add_object(const int8_t obj);
+
+  #endif
+};
+
+extern GcodeIndex gcode_index;
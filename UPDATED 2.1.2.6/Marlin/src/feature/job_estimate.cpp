@@ -0,0 +1,321 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2024 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * feature/job_estimate.cpp - Statistics and print time estimate for the file being printed
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(SD_JOB_ESTIMATE)
+
+#include "job_estimate.h"
+#include "../gcode/gcode.h"
+#include "../module/motion.h"
+#include "../module/planner.h"
+#include "../module/printcounter.h"
+
+JobEstimate job_estimate;
+
+bool JobEstimate::complete; // = false
+float JobEstimate::filament_mm, JobEstimate::seconds;
+uint16_t JobEstimate::max_feedrate;
+
+uint32_t JobEstimate::region_size;
+xyz_pos_t JobEstimate::position;
+bool JobEstimate::relative;
+uint16_t JobEstimate::layer_comments, JobEstimate::z_layers;
+float JobEstimate::layer_z;
+uint32_t JobEstimate::first_move_sdpos;
+uint32_t JobEstimate::start_elapsed;
+JobEstimate::move_t JobEstimate::prev;
+bool JobEstimate::has_prev;
+
+float JobEstimate::region_seconds[SD_JOB_ESTIMATE_REGIONS];
+uint16_t JobEstimate::region_feedrate[SD_JOB_ESTIMATE_REGIONS];
+
+/**
+ * Start the statistics for the file that was just opened,
+ * with the machine state it will be printed with.
+ */
+void JobEstimate::start() {
+  region_size = card.getFileSize() / (SD_JOB_ESTIMATE_REGIONS) + 1;
+  position = current_position;
+  relative = gcode.axis_is_relative(X_AXIS);
+  layer_comments = z_layers = 0;
+  layer_z = -1000;
+  filament_mm = seconds = 0;
+  max_feedrate = 0;
+  first_move_sdpos = UINT32_MAX;
+  start_elapsed = 0;
+  has_prev = false;
+  ZERO(region_seconds);
+  ZERO(region_feedrate);
+  complete = false;
+}
+
+// Leave heating and other waits before the first move out of the time scale
+void JobEstimate::follow_print() {
+  if (!start_elapsed && card.getIndex() > first_move_sdpos && print_job_timer.isRunning())
+    start_elapsed = _MAX(uint32_t(print_job_timer.duration()), uint32_t(1));
+}
+
+// Get a parameter value, stopping at a comment
+static bool parameter(const char *p, const char c, float &value) {
+  for (; *p && *p != ';' && *p != '*'; ++p)
+    if (*p == c) { value = strtof(p + 1, nullptr); return true; }
+  return false;
+}
+
+/**
+ * Update the statistics for a whole line, given the state tracked through it
+ * and the extrusion it added
+ */
+void JobEstimate::scan_line(const char *line, const gcode_mark_t &s, const float de, const bool layer) {
+  if (layer) ++layer_comments;
+
+  const char *p = line;
+  while (*p == ' ') ++p;
+  const char letter = *p++;
+  if (letter != 'G' && letter != 'M') return;
+  char *end;
+  const int code = strtol(p, &end, 10);
+  if (end == p || *end == '.') return;  // No code, or a subcode
+  p = end;
+
+  if (letter == 'M') {
+    if (code == 109 || code == 190 || code == 400) end_move(0); // Moves finish before these
+    return;
+  }
+
+  const uint32_t sdpos = s.sdpos;
+  const uint8_t region = _MIN(sdpos / region_size, uint32_t(SD_JOB_ESTIMATE_REGIONS - 1));
+  float v;
+  switch (code) {
+    case 0: case 1: case 2: case 3: case 5: {
+      xyz_pos_t to = position;
+      if (parameter(p, 'X', v)) to.x = relative ? to.x + v : v;
+      if (parameter(p, 'Y', v)) to.y = relative ? to.y + v : v;
+      if (parameter(p, 'Z', v)) to.z = relative ? to.z + v : v;
+      xyz_float_t dist = to - position;
+      float length = dist.magnitude();
+
+      // Arc length from the center offset (I J) or the radius (R)
+      if (code == 2 || code == 3) {
+        const float chord = HYPOT(dist.x, dist.y);
+        float radius, angle;
+        if (parameter(p, 'R', v)) {
+          radius = ABS(v);
+          angle = chord < 2 * radius ? 2 * asinf(chord / (2 * radius)) : float(M_PI);
+          if (v < 0) angle = RADIANS(360) - angle;
+        }
+        else {
+          float i = 0, j = 0;
+          parameter(p, 'I', i);
+          parameter(p, 'J', j);
+          radius = HYPOT(i, j);
+          const float a_start = ATAN2(-j, -i), a_end = ATAN2(dist.y - j, dist.x - i);
+          angle = code == 2 ? a_start - a_end : a_end - a_start;
+          if (angle <= 0) angle += RADIANS(360);          // A full circle ends where it starts
+        }
+        length = HYPOT(radius * angle, dist.z);
+      }
+
+      position = to;
+      add_move(dist, length, de, MMM_TO_MMS(s.feedrate), region);
+      if (first_move_sdpos == UINT32_MAX) first_move_sdpos = sdpos;
+      if (de > 0 && length > 0 && position.z > layer_z + 0.0001f) {
+        layer_z = position.z;
+        ++z_layers;
+      }
+    } break;
+
+    case 4: {                                           // Dwell
+      end_move(0);
+      const float t = parameter(p, 'P', v) ? v * 0.001f : parameter(p, 'S', v) ? v : 0;
+      region_seconds[region] += t;
+      seconds += t;
+    } break;
+
+    case 28: {                                          // Home to 0, the axes given or all
+      end_move(0);
+      const bool x = parameter(p, 'X', v), y = parameter(p, 'Y', v), z = parameter(p, 'Z', v), all = !(x || y || z);
+      if (all || x) position.x = 0;
+      if (all || y) position.y = 0;
+      if (all || z) position.z = 0;
+    } break;
+
+    case 90: relative = false; break;
+    case 91: relative = true; break;
+
+    case 92:
+      if (parameter(p, 'X', v)) position.x = v;
+      if (parameter(p, 'Y', v)) position.y = v;
+      if (parameter(p, 'Z', v)) position.z = v;
+      break;
+  }
+}
+
+/**
+ * The fastest speed through the corner between two moves, given the cosine
+ * of the angle between their directions (1 for a straight line). The planner
+ * uses the negated cosine, so its half angle formula has 1 + cos_theta here.
+ */
+static float junction_speed(const float cos_theta, const float accel) {
+  #if HAS_JUNCTION_DEVIATION
+    if (cos_theta < -0.999999f) return 0;
+    if (cos_theta > 0.999999f) return __FLT_MAX__;
+    const float sin_theta_d2 = SQRT(0.5f * (1.0f + cos_theta));
+    return SQRT(accel * planner.junction_deviation_mm * sin_theta_d2 / (1.0f - sin_theta_d2));
+  #else
+    UNUSED(accel);
+    return planner.max_jerk.x / _MAX(1.0f - cos_theta, 0.001f);
+  #endif
+}
+
+/**
+ * Limit the speed and acceleration of a move by each axis, and time the
+ * move before it now that the speed between them is known.
+ */
+void JobEstimate::add_move(const xyz_float_t &dist, const float length, const float de, float speed, const uint8_t region) {
+  filament_mm += de;
+
+  const auto &settings = planner.settings;
+  move_t m;
+  m.region = region;
+
+  if (length < 0.0001f) {                               // E-only move
+    if (ABS(de) < 0.0001f) return;
+    m.length = ABS(de);
+    m.unit.reset();
+    NOMORE(speed, settings.max_feedrate_mm_s[E_AXIS]);
+    m.accel = _MIN(settings.retract_acceleration, float(settings.max_acceleration_mm_per_s2[E_AXIS]));
+  }
+  else {
+    m.length = length;
+    const float d = dist.magnitude();
+    if (d > 0.0001f) m.unit = dist * (1.0f / d); else m.unit.reset();
+    m.accel = de > 0 ? settings.acceleration : settings.travel_acceleration;
+    const float ratio[] = { ABS(dist.x) / length, ABS(dist.y) / length, ABS(dist.z) / length, ABS(de) / length };
+    const AxisEnum axis[] = { X_AXIS, Y_AXIS, Z_AXIS, E_AXIS };
+    for (uint8_t i = 0; i < COUNT(axis); ++i) {
+      if (ratio[i] * speed > settings.max_feedrate_mm_s[axis[i]]) speed = settings.max_feedrate_mm_s[axis[i]] / ratio[i];
+      if (ratio[i] * m.accel > settings.max_acceleration_mm_per_s2[axis[i]]) m.accel = settings.max_acceleration_mm_per_s2[axis[i]] / ratio[i];
+    }
+  }
+  m.speed = _MAX(speed, 0.1f);
+  NOLESS(m.accel, 1.0f);
+
+  // Meet the last move at the corner, no faster than it can reach from its entry speed
+  float junction = 0;
+  if (has_prev && m.unit.magnitude() && prev.unit.magnitude()) {
+    const float cos_theta = prev.unit.x * m.unit.x + prev.unit.y * m.unit.y + prev.unit.z * m.unit.z;
+    junction = _MIN(prev.speed, m.speed, SQRT(sq(prev.entry) + 2 * prev.accel * prev.length), junction_speed(cos_theta, m.accel));
+  }
+  end_move(junction);
+
+  m.entry = junction;
+  prev = m;
+  has_prev = true;
+
+  const uint16_t f = uint16_t(MMS_TO_MMM(m.speed));
+  NOLESS(region_feedrate[region], f);
+  NOLESS(max_feedrate, f);
+}
+
+/**
+ * Time the waiting move, accelerating from its entry speed toward its cruise
+ * speed and slowing for the exit speed.
+ */
+void JobEstimate::end_move(const float exit_speed) {
+  if (!has_prev) return;
+  has_prev = false;
+
+  const float a = prev.accel, v = prev.speed, v0 = prev.entry, v1 = _MIN(exit_speed, v),
+              accel_d = (sq(v) - sq(v0)) / (2 * a),
+              decel_d = (sq(v) - sq(v1)) / (2 * a);
+  float t;
+  if (accel_d + decel_d <= prev.length)                 // Reaches cruise speed
+    t = (v - v0) / a + (v - v1) / a + (prev.length - accel_d - decel_d) / v;
+  else {                                                // Peaks between speeding up and slowing down
+    const float peak = SQRT(a * prev.length + 0.5f * (sq(v0) + sq(v1)));
+    t = peak > _MAX(v0, v1) ? (2 * peak - v0 - v1) / a : 2 * prev.length / (v0 + v1);
+  }
+  region_seconds[prev.region] += t;
+  seconds += t;
+}
+
+// Estimated time to print the file up to a position
+float JobEstimate::seconds_to(const uint32_t sdpos) {
+  const uint8_t r = _MIN(sdpos / region_size, uint32_t(SD_JOB_ESTIMATE_REGIONS - 1));
+  float s = 0;
+  for (uint8_t i = 0; i < r; ++i) s += region_seconds[i];
+  return s + region_seconds[r] * (sdpos - r * region_size) / region_size;
+}
+
+uint16_t JobEstimate::permyriad() {
+  if (!complete || seconds <= 0) return 0;
+  return _MIN(uint16_t(10000 * seconds_to(card.getIndex()) / seconds), 10000U);
+}
+
+/**
+ * The time left, scaled by how long the print has taken so far
+ * compared to the estimate, within reason.
+ */
+uint32_t JobEstimate::remaining() {
+  if (!complete) return 0;
+  const float done = seconds_to(card.getIndex());
+  float left = seconds - done;
+  if (start_elapsed && done > 60)
+    left *= constrain((print_job_timer.duration() - start_elapsed) / done, 0.5f, 4.0f);
+  return left > 0 ? uint32_t(left) : 0;
+}
+
+void JobEstimate::report(const bool regions/*=false*/) {
+  if (!region_size) { SERIAL_ECHOLNPGM("No estimate"); return; }
+  const uint32_t filesize = card.getFileSize();
+  SERIAL_ECHOPGM("Layers:", layer_count(), " Filament:", filament_mm, "mm Time:", uint32_t(seconds),
+                 "s Max feedrate:", max_feedrate, "mm/min Scanned:", filesize ? uint8_t(uint64_t(GcodeIndex::scanned()) * 100 / filesize) : 100, "%");
+  if (complete && IS_SD_PRINTING()) SERIAL_ECHOPGM(" Left:", remaining(), "s");
+  SERIAL_EOL();
+  if (regions) for (uint8_t i = 0; i < SD_JOB_ESTIMATE_REGIONS; ++i)
+    SERIAL_ECHOLNPGM(" Region ", i, " Bytes:", i * region_size, " Time:", region_seconds[i], "s Max feedrate:", region_feedrate[i], "mm/min");
+}
+
+#if ENABLED(MARLIN_TEST_BUILD)
+
+  /**
+   * Check the corner speeds: a near-straight junction has to be the fastest
+   * and a near reversal the slowest.
+   */
+  void JobEstimate::test() {
+    const float accel = planner.settings.acceleration,
+                straight = junction_speed(cos(RADIANS(10)), accel),
+                square = junction_speed(0, accel),
+                reverse = junction_speed(cos(RADIANS(170)), accel);
+    SERIAL_ECHOLNPGM("Job estimate junction test: 10deg ", straight, " 90deg ", square, " 170deg ", reverse, "mm/s ",
+                     straight > square && square > reverse ? F("PASS") : F("FAIL"));
+  }
+
+#endif
+
+#endif // SD_JOB_ESTIMATE
@@ -0,0 +1,94 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2024 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * feature/job_estimate.h - Statistics and print time estimate for the file being printed
+ *
+ * The G-code index scan feeds each line of the file to the estimate as it runs ahead
+ * of the print. Moves are timed with the planner's feedrate, acceleration and junction
+ * limits, and the times are kept for equal parts of the file so the time left can be
+ * found for any position in it.
+ */
+
+#include "../inc/MarlinConfig.h"
+#include "gcode_index.h"
+
+class JobEstimate {
+  public:
+    static bool complete;           // The whole file has been scanned
+    static float filament_mm,       // (mm) Net extrusion
+                 seconds;           // (s) Estimated print time
+    static uint16_t max_feedrate;   // (mm/min) Highest speed the planner would reach
+
+    // Layer change comments, or else new Z heights with extrusion
+    static uint16_t layer_count() { return layer_comments ?: z_layers; }
+
+    // Called by the G-code index scan
+    static void start();
+    static void reset() { region_size = 0; complete = false; }
+    static void scan_line(const char *line, const gcode_mark_t &s, const float de, const bool layer);
+    static void finish() { end_move(0); complete = true; }
+    static void follow_print();
+
+    // Estimated time to print the file up to a position
+    static float seconds_to(const uint32_t sdpos);
+
+    // Progress and time left at the print position, or 0 until the scan is complete
+    static uint16_t permyriad();
+    static uint32_t remaining();
+
+    static void report(const bool regions=false);
+
+    #if ENABLED(MARLIN_TEST_BUILD)
+      static void test();
+    #endif
+
+  private:
+    // A move waiting for the next one to find its exit speed
+    typedef struct {
+      xyz_float_t unit;             // Direction, or zero for E-only moves
+      float length,                 // (mm)
+            speed,                  // (mm/s) Cruise speed
+            accel,                  // (mm/s^2)
+            entry;                  // (mm/s) Speed at the start
+      uint8_t region;
+    } move_t;
+
+    static uint32_t region_size;    // Bytes of the file in each region, or 0 with no file
+    static xyz_pos_t position;
+    static bool relative;           // XYZ relative mode (G91)
+    static uint16_t layer_comments, z_layers;
+    static float layer_z;           // Z of the last layer found by extrusion
+    static uint32_t first_move_sdpos; // The print has started moving after this position
+    static uint32_t start_elapsed;    // (s) Print job time when it started moving
+    static move_t prev;
+    static bool has_prev;
+
+    static float region_seconds[SD_JOB_ESTIMATE_REGIONS];
+    static uint16_t region_feedrate[SD_JOB_ESTIMATE_REGIONS];
+
+    static void add_move(const xyz_float_t &dist, const float length, const float de, float speed, const uint8_t region);
+    static void end_move(const float exit_speed);
+};
+
+extern JobEstimate job_estimate;
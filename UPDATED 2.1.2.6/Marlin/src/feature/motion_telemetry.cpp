@@ -0,0 +1,162 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2024 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * motion_telemetry.cpp - Stream a record of the stepper's work on each block
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(MOTION_TELEMETRY)
+
+#include "motion_telemetry.h"
+#include "../libs/crc16.h"
+
+MotionTelemetry motion_telemetry;
+
+bool MotionTelemetry::enabled, MotionTelemetry::moving;
+uint32_t MotionTelemetry::ticks;
+uint16_t MotionTelemetry::overruns, MotionTelemetry::loop_limits, MotionTelemetry::dropped_sent;
+telemetry_record_t MotionTelemetry::ring[MOTION_TELEMETRY_RECORDS];
+volatile uint8_t MotionTelemetry::head, MotionTelemetry::tail;
+volatile uint16_t MotionTelemetry::dropped;
+#if HAS_MULTI_SERIAL
+  SerialMask MotionTelemetry::port_mask;
+#endif
+
+void MotionTelemetry::enable(const bool onoff OPTARG(HAS_MULTI_SERIAL, const serial_index_t port)) {
+  enabled = false;
+  if (onoff) {
+    TERN_(HAS_MULTI_SERIAL, port_mask = SERIAL_PORTMASK(port));
+    head = tail = 0;
+    ticks = 0;
+    overruns = loop_limits = 0;
+    dropped = dropped_sent = 0;
+    moving = false;
+    enabled = true;
+  }
+}
+
+void MotionTelemetry::report() {
+  SERIAL_ECHOLNPGM("Telemetry ", enabled ? F("ON") : F("OFF"),
+    " Overruns:", overruns, " Loop limits:", loop_limits, " Dropped:", dropped
+  );
+}
+
+// Get the record at the head, or nullptr if the ring is full. Call publish() to add it.
+telemetry_record_t* MotionTelemetry::next_record(const TelemetryType type) {
+  if (((head + 1) & (MOTION_TELEMETRY_RECORDS - 1)) == tail) { ++dropped; return nullptr; }
+  telemetry_record_t * const r = &ring[head];
+  r->type = type;
+  r->fill = planner.movesplanned();
+  r->ticks = ticks;
+  r->overruns = overruns;
+  r->loop_limits = loop_limits;
+  return r;
+}
+
+void MotionTelemetry::isr_block_start(const block_t * const block) {
+  moving = true;
+  if (!enabled) return;
+  telemetry_record_t * const r = next_record(TELEMETRY_BLOCK_START);
+  if (!r) return;
+  r->initial_rate = block->initial_rate;
+  r->nominal_rate = block->nominal_rate;
+  r->final_rate = block->final_rate;
+  r->steps = block->step_event_count;
+  publish();
+}
+
+void MotionTelemetry::isr_block_end() {
+  if (enabled && next_record(TELEMETRY_BLOCK_END)) publish();
+}
+
+// Called when the stepper finds no block. Record only the first time after a move.
+void MotionTelemetry::isr_starved() {
+  if (!moving) return;
+  moving = false;
+  if (enabled && next_record(TELEMETRY_STARVED)) publish();
+}
+
+void MotionTelemetry::slowdown(const uint16_t queued_ms, const uint32_t feed_interval_us, const float factor) {
+  telemetry_record_t * const r = next_record(TELEMETRY_SLOWDOWN);
+  if (!r) return;
+  r->queued_ms = queued_ms;
+  r->feed_interval_us = feed_interval_us;
+  r->percent = uint8_t(factor * 100);
+  publish();
+}
+
+void MotionTelemetry::send_frame(const TelemetryType type, const uint8_t * const payload, const uint8_t length) {
+  uint16_t crc = 0;
+  const uint8_t header[] = { uint8_t(type), length };
+  crc16(&crc, header, 2);
+  crc16(&crc, payload, length);
+  SERIAL_CHAR(char(0xA5), char(0x5A), char(type), char(length));
+  for (uint8_t i = 0; i < length; ++i) SERIAL_CHAR(char(payload[i]));
+  SERIAL_CHAR(char(crc & 0xFF), char(crc >> 8));
+}
+
+static uint8_t* put16(uint8_t *p, const uint16_t v) { *p++ = v & 0xFF; *p++ = v >> 8; return p; }
+static uint8_t* put32(uint8_t *p, const uint32_t v) { return put16(put16(p, v & 0xFFFF), v >> 16); }
+
+void MotionTelemetry::stream() {
+  if (!enabled || (tail == head && dropped == dropped_sent)) return;
+
+  PORT_REDIRECT(port_mask);
+
+  uint8_t buf[21];
+  const uint16_t lost = dropped;
+  if (lost != dropped_sent) {
+    put16(buf, lost - dropped_sent);
+    send_frame(TELEMETRY_DROPPED, buf, 2);
+    dropped_sent = lost;
+  }
+
+  // A few records per call to keep idle() responsive
+  for (uint8_t n = 0; n < 4 && tail != head; ++n) {
+    __asm__ __volatile__("" ::: "memory"); // Read the record only after seeing the new head
+    const telemetry_record_t &r = ring[tail];
+    uint8_t *p = put32(buf, r.ticks);
+    switch (r.type) {
+      case TELEMETRY_BLOCK_START:
+        *p++ = r.fill;
+        p = put32(put32(put32(put32(p, r.initial_rate), r.nominal_rate), r.final_rate), r.steps);
+        break;
+      case TELEMETRY_BLOCK_END:
+        p = put16(put16(p, r.overruns), r.loop_limits);
+        break;
+      case TELEMETRY_SLOWDOWN:
+        *p++ = r.fill;
+        p = put32(put16(p, r.queued_ms), r.feed_interval_us);
+        *p++ = r.percent;
+        break;
+      default: break;
+    }
+    send_frame(r.type, buf, p - buf);
+    tail = (tail + 1) & (MOTION_TELEMETRY_RECORDS - 1);
+  }
+
+  PORT_RESTORE();
+}
+
+#endif // MOTION_TELEMETRY
@@ -0,0 +1,110 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2024 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * motion_telemetry.h - Stream a record of the stepper's work on each block
+ *
+ * The stepper ISR adds a record to a ring buffer at the start and end of each
+ * block and when the planner runs dry. SLOWDOWN_ADAPTIVE adds a record, with
+ * the stepper ISR held off, for each block it slows to avoid running dry.
+ * idle() sends the records to the host that enabled them with M577, as binary
+ * frames between the usual text lines.
+ * Only the ISR moves the head and only idle() moves the tail, so neither side
+ * needs to lock the other out.
+ *
+ * Frame: 0xA5 0x5A <type> <length> <payload> <crc16>
+ * The CRC-16/XMODEM covers type, length and payload. Values are little-endian.
+ * Decode with buildroot/share/scripts/telemetry_decode.py
+ */
+
+#include "../inc/MarlinConfig.h"
+#include "../module/planner.h"
+
+enum TelemetryType : uint8_t {
+  TELEMETRY_BLOCK_START = 'S',  // ticks(4) fill(1) initial_rate(4) nominal_rate(4) final_rate(4) steps(4)
+  TELEMETRY_BLOCK_END   = 'E',  // ticks(4) overruns(2) loop_limits(2)
+  TELEMETRY_STARVED     = 'U',  // ticks(4)                             The stepper found the planner empty
+  TELEMETRY_SLOWDOWN    = 'P',  // ticks(4) fill(1) queued_ms(2) feed_interval_us(4) percent(1)
+                                //                                      A block slowed to prevent an underrun
+  TELEMETRY_DROPPED     = 'D'   // count(2)                             Records lost to a full ring buffer
+};
+
+typedef struct {
+  TelemetryType type;
+  uint8_t fill;                 // Blocks in the planner, including this one
+  uint16_t overruns,            // Stepper ISRs so far that ran late and looped to catch up
+           loop_limits;         // Stepper ISRs so far that gave up catching up (max_loops)
+  uint32_t ticks,               // Stepper timer ticks since telemetry was enabled
+           initial_rate,        // Step rates of the block (steps/s)
+           nominal_rate,
+           final_rate,
+           steps;               // Step events in the block
+  uint16_t queued_ms;           // Planned motion queued behind the busy block
+  uint32_t feed_interval_us;    // Average time between new blocks
+  uint8_t percent;              // Speed of the slowed block
+} telemetry_record_t;
+
+class MotionTelemetry {
+  public:
+    static bool enabled;
+    static uint32_t ticks;
+    static uint16_t overruns, loop_limits;
+
+    static void enable(const bool onoff OPTARG(HAS_MULTI_SERIAL, const serial_index_t port));
+    static void report();
+
+    // Send waiting records. Called from idle().
+    static void stream();
+
+    // Stepper ISR hooks
+    static void isr_block_start(const block_t * const block);
+    static void isr_block_end();
+    static void isr_starved();
+
+    // Planner hook, with the stepper ISR suspended
+    static void slowdown(const uint16_t queued_ms, const uint32_t feed_interval_us, const float factor);
+
+    // At the end of each stepper ISR, with the ticks to the next and the loops left
+    FORCE_INLINE static void isr_done(const hal_timer_t next_isr_ticks, const uint8_t loops_left) {
+      if (!enabled) return;
+      ticks += next_isr_ticks;
+      if (loops_left < 9) ++overruns;
+      if (!loops_left) ++loop_limits;
+    }
+
+  private:
+    static telemetry_record_t ring[MOTION_TELEMETRY_RECORDS];
+    static volatile uint8_t head, tail;
+    static volatile uint16_t dropped;
+    static uint16_t dropped_sent;
+    static bool moving;
+    #if HAS_MULTI_SERIAL
+      static SerialMask port_mask;
+    #endif
+
+    static telemetry_record_t* next_record(const TelemetryType type);
+    static void publish() { head = (head + 1) & (MOTION_TELEMETRY_RECORDS - 1); }
+    static void send_frame(const TelemetryType type, const uint8_t * const payload, const uint8_t length);
+};
+
+extern MotionTelemetry motion_telemetry;
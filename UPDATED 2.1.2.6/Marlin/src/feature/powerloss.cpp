@@ -48,6 +48,10 @@ uint32_t PrintJobRecovery::cmd_sdpos, // = 0
   bool PrintJobRecovery::dwin_flag; // = false
 #endif
 
+#if ENABLED(POWER_LOSS_JOURNAL)
+  PrintJobRecovery::journal_t PrintJobRecovery::journal; // = { 0 }
+#endif
+
 #include "../sd/cardreader.h"
 #include "../lcd/marlinui.h"
 #include "../gcode/queue.h"
@@ -66,6 +70,10 @@ uint32_t PrintJobRecovery::cmd_sdpos, // = 0
   #include "fwretract.h"
 #endif
 
+#if ENABLED(POWER_LOSS_JOURNAL)
+  #include "../libs/crc16.h"
+#endif
+
 #define DEBUG_OUT ENABLED(DEBUG_POWER_LOSS_RECOVERY)
 #include "../core/debug_out.h"
 
@@ -92,7 +100,14 @@ PrintJobRecovery recovery;
 /**
  * Clear the recovery info
  */
-void PrintJobRecovery::init() { info = {}; }
+void PrintJobRecovery::init() {
+  info = {};
+  #if ENABLED(POWER_LOSS_JOURNAL)
+    const uint32_t sequence = journal.sequence;
+    journal = {};
+    journal.sequence = sequence;    // Keep counting so older records never match new ones
+  #endif
+}
 
 /**
  * Enable or disable then call changed()
@@ -135,10 +150,18 @@ bool PrintJobRecovery::check() {
 }
 
 /**
- * Delete the recovery file and clear the recovery data
+ * Delete the recovery file and clear the recovery data.
+ * A journal is kept for the next job, with its full records cleared.
  */
 void PrintJobRecovery::purge() {
   init();
+  #if ENABLED(POWER_LOSS_JOURNAL)
+    uint32_t first;
+    if (card.findJobRecoveryJournal(first)) {
+      if (!card.clearJobRecoveryJournal(first, 2)) DEBUG_ECHOLNPGM("Power-loss journal clear failed.");
+      return;
+    }
+  #endif
   card.removeJobRecoveryFile();
 }
 
@@ -146,11 +169,15 @@ void PrintJobRecovery::purge() {
  * Load the recovery data, if it exists
  */
 void PrintJobRecovery::load() {
-  if (exists()) {
-    open(true);
-    (void)file.read(&info, sizeof(info));
-    close();
-  }
+  #if ENABLED(POWER_LOSS_JOURNAL)
+    journal_load();
+  #else
+    if (exists()) {
+      open(true);
+      (void)file.read(&info, sizeof(info));
+      close();
+    }
+  #endif
   debug(F("Load"));
 }
 
@@ -160,6 +187,7 @@ void PrintJobRecovery::load() {
 void PrintJobRecovery::prepare() {
   card.getAbsFilenameInCWD(info.sd_filename);  // SD filename
   cmd_sdpos = 0;
+  TERN_(POWER_LOSS_JOURNAL, journal.block = 0); // Start a new journal at the first save
 }
 
 /**
@@ -346,13 +374,128 @@ void PrintJobRecovery::write() {
 
   debug(F("Write"));
 
-  open(false);
-  file.seekSet(0);
-  const int16_t ret = file.write(&info, sizeof(info));
-  if (ret == -1) DEBUG_ECHOLNPGM("Power-loss file write failed.");
-  if (!file.close()) DEBUG_ECHOLNPGM("Power-loss file close failed.");
+  #if ENABLED(POWER_LOSS_JOURNAL)
+    if (!journal_write()) DEBUG_ECHOLNPGM("Power-loss journal write failed.");
+  #else
+    open(false);
+    file.seekSet(0);
+    const int16_t ret = file.write(&info, sizeof(info));
+    if (ret == -1) DEBUG_ECHOLNPGM("Power-loss file write failed.");
+    if (!file.close()) DEBUG_ECHOLNPGM("Power-loss file close failed.");
+  #endif
 }
 
+#if ENABLED(POWER_LOSS_JOURNAL)
+
+  // Copy the fields that change at every save between the info and a delta
+  static void get_delta(plr_delta_t &d, const job_recovery_info_t &i) {
+    d.current_position = i.current_position;
+    d.sdpos = i.sdpos;
+    d.feedrate = i.feedrate;
+    d.zraise = i.zraise;
+    d.raised = i.flag.raised;
+    d.print_job_elapsed = i.print_job_elapsed;
+  }
+  static void put_delta(job_recovery_info_t &i, const plr_delta_t &d) {
+    i.current_position = d.current_position;
+    i.sdpos = d.sdpos;
+    i.feedrate = d.feedrate;
+    i.zraise = d.zraise;
+    i.flag.raised = d.raised;
+    i.print_job_elapsed = d.print_job_elapsed;
+  }
+
+  static uint16_t record_size(const plr_record_t &r) { return (const uint8_t*)&r.info - (const uint8_t*)&r + r.size; }
+
+  static uint16_t record_crc(const plr_record_t &r) {
+    uint16_t crc = 0;
+    crc16(&crc, &r.size, record_size(r) - sizeof(r.crc));
+    return crc;
+  }
+
+  /**
+   * Write the info to the journal with a single block write. Write a delta
+   * if the rest of the info matches the last full record, otherwise write a
+   * full record to the other full record block.
+   */
+  bool PrintJobRecovery::journal_write() {
+    if (!journal.block) {
+      // With no records loaded, older ones could have the same sequence numbers, so clear them
+      if (!card.startJobRecoveryJournal(journal.block, !journal.sequence)) { journal.block = 0; return false; }
+      journal.base = 0;
+      journal.next = 2;
+    }
+
+    plr_record_t r;
+    r.info = info; // Work on a copy, leaving out the delta to get the CRC
+
+    // Get the CRC of the info without the delta
+    plr_delta_t d;
+    get_delta(d, r.info);
+    const uint8_t valid = r.info.valid_head;
+    put_delta(r.info, {});
+    r.info.valid_head = r.info.valid_foot = 0;
+    uint16_t crc = 0;
+    crc16(&crc, &r.info, sizeof(r.info));
+
+    uint32_t block;
+    r.sequence = ++journal.sequence;
+    if (!journal.base || crc != journal.base_crc) {
+      put_delta(r.info, d);
+      r.info.valid_head = r.info.valid_foot = valid;
+      r.base = r.sequence;
+      r.size = sizeof(r.info);
+      // Keep the last full record until this one is written
+      const uint8_t slot = journal.base ? !journal.slot : 0;
+      block = journal.block + slot;
+      journal.slot = slot;
+      journal.base = r.sequence;
+      journal.base_crc = crc;
+    }
+    else {
+      r.delta = d;
+      r.base = journal.base;
+      r.size = sizeof(r.delta);
+      block = journal.block + journal.next;
+      if (++journal.next >= POWER_LOSS_JOURNAL_BLOCKS) journal.next = 2;
+    }
+    r.crc = record_crc(r);
+    return card.writeJobRecoveryBlock(block, &r, record_size(r));
+  }
+
+  /**
+   * Load the newest full record in the journal and apply the newest
+   * delta made from it. New records are numbered after all the old ones.
+   */
+  void PrintJobRecovery::journal_load() {
+    uint32_t first;
+    if (!card.findJobRecoveryJournal(first)) return;
+
+    plr_record_t r;
+    auto read_record = [&](const uint8_t b, const uint16_t size) {
+      if (!card.readJobRecoveryBlock(first + b, &r, sizeof(r))
+        || !r.sequence || r.size != size || r.crc != record_crc(r)) return false;
+      NOLESS(journal.sequence, r.sequence);
+      return true;
+    };
+
+    uint32_t base = 0;
+    for (uint8_t b = 0; b < 2; ++b)
+      if (read_record(b, sizeof(r.info)) && r.base == r.sequence && r.sequence > base) {
+        base = r.sequence;
+        info = r.info;
+      }
+
+    uint32_t newest = base;
+    for (uint8_t b = 2; b < POWER_LOSS_JOURNAL_BLOCKS; ++b)
+      if (read_record(b, sizeof(r.delta)) && base && r.base == base && r.sequence > newest) {
+        newest = r.sequence;
+        put_delta(info, r.delta);
+      }
+  }
+
+#endif // POWER_LOSS_JOURNAL
+
 /**
  * Resume the saved print job
  */
@@ -134,6 +134,38 @@ typedef struct {
 
 } job_recovery_info_t;
 
+#if ENABLED(POWER_LOSS_JOURNAL)
+
+  // The state that changes at every save
+  typedef struct {
+    xyze_pos_t current_position;
+    uint32_t sdpos;
+    uint16_t feedrate;
+    float zraise;
+    bool raised;
+    millis_t print_job_elapsed;
+  } plr_delta_t;
+
+  /**
+   * A journal block holds one record: the full job_recovery_info_t
+   * (in the first two blocks, alternating) or a plr_delta_t for the
+   * full record with the sequence number in 'base'.
+   */
+  typedef struct {
+    uint16_t crc;         // CRC16 of the rest of the record
+    uint16_t size;        // Size of the data
+    uint32_t sequence;    // Order of writing, starting at 1
+    uint32_t base;        // Sequence of the full record. Same as 'sequence' for a full record.
+    union {
+      job_recovery_info_t info;
+      plr_delta_t delta;
+    };
+  } plr_record_t;
+
+  static_assert(sizeof(plr_record_t) <= 512, "job_recovery_info_t is too large for POWER_LOSS_JOURNAL.");
+
+#endif
+
 class PrintJobRecovery {
   public:
     static const char filename[5];
@@ -215,6 +247,19 @@ class PrintJobRecovery {
   private:
     static void write();
 
+    #if ENABLED(POWER_LOSS_JOURNAL)
+      static struct journal_t {
+        uint32_t block,     // First block of the journal, or 0 before the first save of a job
+                 sequence,  // Sequence of the last record written
+                 base;      // Sequence of the last full record written
+        uint16_t base_crc;  // CRC of the last full record, leaving out the delta
+        uint8_t slot,       // Block of the last full record (0 or 1)
+                next;       // Next block for a delta record
+      } journal;
+      static void journal_load();
+      static bool journal_write();
+    #endif
+
     #if ENABLED(BACKUP_POWER_SUPPLY)
       static void retract_and_lift(const_float_t zraise);
     #endif
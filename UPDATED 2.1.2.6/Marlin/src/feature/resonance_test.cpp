@@ -0,0 +1,288 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2024 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * resonance_test.cpp - Measure the resonances of an axis for input shaping
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(SHAPING_AUTOTUNE)
+
+#include "resonance_test.h"
+#include "accelerometer.h"
+#include "../libs/fft.h"
+#include "../module/motion.h"
+#include "../module/planner.h"
+#include "../module/stepper.h"
+
+ResonanceTest resonance_test;
+
+static constexpr uint8_t log2_size(const uint16_t n) { return n > 1 ? 1 + log2_size(n >> 1) : 0; }
+typedef FixedFFT<log2_size(SHAPING_AUTOTUNE_FFT_SIZE)> ResonanceFFT;
+
+bool ResonanceTest::active; // = false
+uint16_t ResonanceTest::fill, ResonanceTest::windows;
+int16_t ResonanceTest::samples[3][window], ResonanceTest::imag[window];
+float ResonanceTest::spectrum[window / 2 + 1];
+resonance_peak_t ResonanceTest::peaks[peak_count];
+
+void ResonanceTest::reset() {
+  ResonanceFFT::init();
+  fill = windows = 0;
+  ZERO(spectrum);
+}
+
+// Read everything the sensor has buffered, transforming each full window
+void ResonanceTest::collect() {
+  xyz_int_t buf[8];
+  for (;;) {
+    const uint8_t count = Accelerometer::read(buf, _MIN(uint16_t(COUNT(buf)), uint16_t(window - fill)));
+    if (!count) break;
+    for (uint8_t i = 0; i < count; ++i, ++fill) {
+      samples[0][fill] = buf[i].x;
+      samples[1][fill] = buf[i].y;
+      samples[2][fill] = buf[i].z;
+    }
+    if (fill == window) { add_window(); fill = 0; }
+  }
+}
+
+/**
+ * Add the power spectrum of each sensor axis to the total so the sensor
+ * may be mounted in any orientation. The mean is removed and the samples
+ * scaled to fill the FFT input range, then the power is scaled back.
+ */
+void ResonanceTest::add_window() {
+  for (uint8_t a = 0; a < 3; ++a) {
+    int16_t * const re = samples[a];
+    int32_t sum = 0;
+    for (uint16_t i = 0; i < window; ++i) sum += re[i];
+    const int16_t mean = sum / window;
+    int32_t peak = 1;
+    for (uint16_t i = 0; i < window; ++i) NOLESS(peak, ABS(int32_t(re[i]) - mean));
+
+    int8_t up = 0;
+    while (peak > 16383) { peak >>= 1; --up; }
+    while (peak <= 8191) { peak <<= 1; ++up; }
+
+    for (uint16_t i = 0; i < window; ++i) {
+      int32_t v = int32_t(re[i]) - mean;
+      v = up >= 0 ? v << up : v >> -up;
+      re[i] = (v * ResonanceFFT::hann(i)) >> 15;
+      imag[i] = 0;
+    }
+
+    ResonanceFFT::transform(re, imag);
+
+    const float scale = ldexpf(1.0f, -2 * up);
+    for (uint16_t k = 0; k <= window / 2; ++k)
+      spectrum[k] += (sq(int32_t(re[k])) + sq(int32_t(imag[k]))) * scale;
+  }
+  ++windows;
+}
+
+/**
+ * Find the strongest local maxima within the sweep range. The frequency of
+ * each is refined with a parabola through the log power of its neighbors and
+ * the damping ratio comes from the width of the peak at half power, less the
+ * width of the Hann window's main lobe (1.44 bins).
+ */
+uint8_t ResonanceTest::find_peaks(const float bin_hz) {
+  ZERO(peaks);
+  const uint16_t kmin = _MAX(2, uint16_t(CEIL(float(SHAPING_AUTOTUNE_FREQ_MIN) / bin_hz))),
+                 kmax = _MIN(window / 2 - 2, uint16_t(float(SHAPING_AUTOTUNE_FREQ_MAX) / bin_hz));
+  uint8_t found = 0;
+  float top = 0;
+  for (uint16_t k = kmin; k <= kmax; ++k) {
+    const float p = spectrum[k];
+    if (!(p > spectrum[k - 1] && p >= spectrum[k + 1])) continue;
+
+    const float a = logf(spectrum[k - 1] + 1e-6f), b = logf(p + 1e-6f), c = logf(spectrum[k + 1] + 1e-6f),
+                d = a - 2 * b + c, offset = d < 0 ? 0.5f * (a - c) / d : 0,
+                freq = (k + offset) * bin_hz;
+
+    // Half power crossings on either side
+    const float half = p * 0.5f;
+    uint16_t l = k, r = k;
+    while (l > 1 && spectrum[l - 1] > half) --l;
+    while (r < window / 2 - 1 && spectrum[r + 1] > half) ++r;
+    const float fl = l - 1 + (half - spectrum[l - 1]) / (spectrum[l] - spectrum[l - 1]),
+                fr = r + (spectrum[r] - half) / (spectrum[r] - spectrum[r + 1]),
+                lobe = 1.44f,
+                width = SQRT(_MAX(sq(fr - fl) - sq(lobe), 0.0f)) * bin_hz;
+    const resonance_peak_t peak = { freq, p, constrain(width / (2 * freq), 0.01f, 0.5f) };
+
+    // Insert by power
+    uint8_t i = _MIN(found, peak_count - 1);
+    if (found == peak_count && peaks[i].power >= p) continue;
+    for (; i > 0 && peaks[i - 1].power < p; --i) peaks[i] = peaks[i - 1];
+    peaks[i] = peak;
+    if (found < peak_count) ++found;
+    NOLESS(top, p);
+  }
+  for (uint8_t i = 0; i < found; ++i) peaks[i].power /= top;
+  return found;
+}
+
+void ResonanceTest::run(const AxisEnum axis, const bool apply) {
+  if (homing_needed_error(_BV(X_AXIS) | _BV(Y_AXIS))) return;
+
+  if (!Accelerometer::begin()) {
+    SERIAL_ECHO_MSG("?Accelerometer not responding");
+    return;
+  }
+
+  // Sweep from the bed center with the axis shaper off and the acceleration limits raised
+  do_blocking_move_to_xy(X_CENTER, Y_CENTER);
+
+  const float saved_freq = stepper.get_shaping_frequency(axis),
+              saved_max_accel = planner.settings.max_acceleration_mm_per_s2[axis],
+              saved_travel_accel = planner.settings.travel_acceleration;
+  stepper.set_shaping_frequency(axis, 0);
+  planner.set_max_acceleration(axis, float(SHAPING_AUTOTUNE_ACCEL_PER_HZ) * (SHAPING_AUTOTUNE_FREQ_MAX));
+
+  SERIAL_ECHOLNPGM("Resonance sweep ", C(AXIS_CHAR(axis)), " ", SHAPING_AUTOTUNE_FREQ_MIN, "-", SHAPING_AUTOTUNE_FREQ_MAX, "Hz");
+
+  // Drop any samples taken before the sweep
+  xyz_int_t discard[8];
+  while (Accelerometer::read(discard, COUNT(discard))) { /* nada */ }
+  reset();
+  active = true;
+
+  /**
+   * Each move accelerates for half its time and decelerates for the other
+   * half, so two moves make one cycle of a square wave of acceleration at
+   * 'freq'. The frequency rises by SHAPING_AUTOTUNE_HZ_PER_SEC every second.
+   * The acceleration rises with the frequency to keep the higher frequency
+   * moves from shrinking to a few steps.
+   */
+  const float center = current_position[axis];
+  float freq = SHAPING_AUTOTUNE_FREQ_MIN;
+  for (bool out = true; freq <= SHAPING_AUTOTUNE_FREQ_MAX; out = !out) {
+    const float half_period = 0.5f / freq,
+                accel = (SHAPING_AUTOTUNE_ACCEL_PER_HZ) * freq,
+                amplitude = accel * sq(half_period) / 8;
+    current_position[axis] = center + (out ? amplitude : -amplitude);
+    planner.settings.travel_acceleration = accel;
+    // The nominal speed is above the peak (accel * half_period / 2) so the move is all acceleration
+    planner.buffer_line(current_position, accel * half_period);
+    freq += (SHAPING_AUTOTUNE_HZ_PER_SEC) * half_period;
+  }
+  planner.settings.travel_acceleration = saved_travel_accel;
+  current_position[axis] = center;
+  planner.buffer_line(current_position, feedrate_mm_s);
+  planner.synchronize();
+
+  active = false;
+  Accelerometer::end();
+
+  planner.set_max_acceleration(axis, saved_max_accel);
+  stepper.set_shaping_frequency(axis, saved_freq);
+
+  if (!windows) {
+    SERIAL_ECHO_MSG("?No accelerometer samples");
+    return;
+  }
+
+  const uint8_t found = find_peaks(float(Accelerometer::sample_rate) / window);
+  if (!found) {
+    SERIAL_ECHO_MSG("?No resonance found");
+    return;
+  }
+
+  for (uint8_t i = 0; i < found; ++i) {
+    SERIAL_ECHOPGM("  Peak ", i + 1, ": ");
+    SERIAL_ECHO_F(peaks[i].freq, 1);
+    SERIAL_ECHOPGM("Hz power ");
+    SERIAL_ECHO_F(peaks[i].power * 100, 0);
+    SERIAL_ECHOPGM("% zeta ");
+    SERIAL_ECHO_F(peaks[i].zeta, 3);
+    SERIAL_EOL();
+  }
+
+  /**
+   * Recommend a shaper for the strongest peak. With the multi-impulse shapers,
+   * a strong second peak nearby is covered by a wider shaper placed between
+   * the two: EI spans about ±20% and 2HUMP_EI about ±35%.
+   */
+  float shaper_freq = peaks[0].freq, shaper_zeta = peaks[0].zeta;
+  #if ENABLED(SHAPING_MULTI_IMPULSE)
+    ShapingType type = SHAPER_MZV;
+    if (found > 1 && peaks[1].power >= 0.25f) {
+      const float ratio = _MAX(peaks[0].freq, peaks[1].freq) / _MIN(peaks[0].freq, peaks[1].freq);
+      if (ratio <= 1.6f) {
+        type = ratio <= 1.25f ? SHAPER_EI : SHAPER_2HUMP_EI;
+        shaper_freq = SQRT(peaks[0].freq * peaks[1].freq);
+        shaper_zeta = _MIN(peaks[0].zeta, peaks[1].zeta);
+      }
+    }
+  #endif
+
+  SERIAL_ECHOPGM("Recommended: M593 ", C(AXIS_CHAR(axis)), " F");
+  SERIAL_ECHO_F(shaper_freq, 1);
+  SERIAL_ECHOPGM(" D");
+  SERIAL_ECHO_F(shaper_zeta, 2);
+  #if ENABLED(SHAPING_MULTI_IMPULSE)
+    SERIAL_ECHOPGM(" T", int(type));
+  #endif
+  SERIAL_EOL();
+
+  if (apply) {
+    stepper.set_shaping_damping_ratio(axis, shaper_zeta);
+    TERN_(SHAPING_MULTI_IMPULSE, stepper.set_shaping_type(axis, type));
+    stepper.set_shaping_frequency(axis, shaper_freq);
+  }
+}
+
+#if ENABLED(MARLIN_TEST_BUILD)
+
+  /**
+   * Feed two tones through the analysis as if they came from the sensor
+   * and check the peak frequencies and order.
+   */
+  void ResonanceTest::test() {
+    constexpr float f1 = 47.3f, f2 = 83.0f, rate = Accelerometer::sample_rate;
+    reset();
+    uint32_t n = 0;
+    for (uint8_t w = 0; w < 8; ++w) {
+      for (fill = 0; fill < window; ++fill, ++n) {
+        const float t = n / rate;
+        samples[0][fill] = int16_t(ACCEL_COUNTS_PER_G + 600 * sinf(2 * float(M_PI) * f1 * t));
+        samples[1][fill] = int16_t(200 * sinf(2 * float(M_PI) * f2 * t));
+        samples[2][fill] = int16_t((n * 7919) % 17) - 8;
+      }
+      add_window();
+    }
+    fill = 0;
+    const uint8_t found = find_peaks(rate / window);
+    const bool pass = found >= 2 && ABS(peaks[0].freq - f1) < 0.5f && ABS(peaks[1].freq - f2) < 0.5f;
+    SERIAL_ECHOPGM("Resonance test: peaks ");
+    SERIAL_ECHO_F(peaks[0].freq, 2);
+    SERIAL_ECHOPGM("Hz ");
+    SERIAL_ECHO_F(peaks[1].freq, 2);
+    SERIAL_ECHOLNPGM("Hz (expect ", f1, " ", f2, ") ", pass ? F("PASS") : F("FAIL"));
+  }
+
+#endif // MARLIN_TEST_BUILD
+
+#endif // SHAPING_AUTOTUNE
@@ -0,0 +1,71 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2024 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * resonance_test.h - Measure the resonances of an axis for input shaping (M593 A)
+ *
+ * The axis is shaken back and forth with short triangular moves through a
+ * rising frequency sweep while the accelerometer is read in idle(). Each full
+ * window of samples is transformed by a fixed-point FFT and its power added
+ * to the spectrum. The strongest peaks of the spectrum give the frequency and
+ * damping for the shaper.
+ */
+
+#include "../inc/MarlinConfig.h"
+
+struct resonance_peak_t {
+  float freq,   // (Hz)
+        power,  // Relative to the strongest peak
+        zeta;   // Damping ratio from the half-power bandwidth
+};
+
+class ResonanceTest {
+  public:
+    static constexpr uint16_t window = SHAPING_AUTOTUNE_FFT_SIZE;
+    static constexpr uint8_t peak_count = 3;
+
+    static resonance_peak_t peaks[peak_count];  // Strongest first, zero power if not found
+
+    // Sweep the axis and report the peaks and the recommended shaper. Apply it if 'apply' is set.
+    static void run(const AxisEnum axis, const bool apply);
+
+    // Gather samples while the sweep is running
+    static void idle() { if (active) collect(); }
+
+    #if ENABLED(MARLIN_TEST_BUILD)
+      static void test();
+    #endif
+
+  private:
+    static bool active;
+    static uint16_t fill, windows;
+    static int16_t samples[3][window], imag[window];
+    static float spectrum[window / 2 + 1];
+
+    static void reset();
+    static void collect();
+    static void add_window();
+    static uint8_t find_peaks(const float bin_hz);
+};
+
+extern ResonanceTest resonance_test;
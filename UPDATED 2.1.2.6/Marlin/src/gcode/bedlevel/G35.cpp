@@ -37,6 +37,10 @@
   #include "../../feature/bltouch.h"
 #endif
 
+#if ENABLED(LSF_ROBUST_FIT)
+  #include "../../libs/least_squares_fit.h"
+#endif
+
 #define DEBUG_OUT ENABLED(DEBUG_LEVELING_FEATURE)
 #include "../../core/debug_out.h"
 
@@ -130,6 +134,21 @@ void GcodeSuite::G35() {
   }
 
   if (!err_break) {
+    #if ENABLED(LSF_ROBUST_FIT)
+      // Report how far the probed points are from a common plane (bed twist)
+      if (G35_PROBE_COUNT > 3) {
+        float probe_x[G35_PROBE_COUNT], probe_y[G35_PROBE_COUNT];
+        for (uint8_t i = 0; i < G35_PROBE_COUNT; ++i) {
+          probe_x[i] = tramming_points[i].x;
+          probe_y[i] = tramming_points[i].y;
+        }
+        linear_fit_data lfd;
+        lsf_residuals lsf_res;
+        if (!finish_robust_LSF(&lfd, probe_x, probe_y, z_measured, G35_PROBE_COUNT, LSF_OUTLIER_THRESHOLD, &lsf_res))
+          report_LSF_residuals(lsf_res);
+      }
+    #endif
+
     const float threads_factor[] = { 0.5, 0.7, 0.8 };
 
     // Calculate adjusts
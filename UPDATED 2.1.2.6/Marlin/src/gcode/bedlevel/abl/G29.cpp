@@ -822,7 +822,14 @@ G29_TYPE GcodeSuite::G29() {
        */
       struct { float a, b, d; } plane_equation_coefficients;
 
-      finish_incremental_LSF(&lsf_results);
+      #if ENABLED(LSF_ROBUST_FIT)
+        const float * const probe_x = abl.eqnAMatrix + 0 * abl.abl_points,
+                    * const probe_y = abl.eqnAMatrix + 1 * abl.abl_points;
+        lsf_residuals lsf_res;
+        finish_robust_LSF(&lsf_results, probe_x, probe_y, abl.eqnBVector, abl.abl_points, LSF_OUTLIER_THRESHOLD, &lsf_res);
+      #else
+        finish_incremental_LSF(&lsf_results);
+      #endif
       plane_equation_coefficients.a = -lsf_results.A;  // We should be able to eliminate the '-' on these three lines and down below
       plane_equation_coefficients.b = -lsf_results.B;  // but that is not yet tested.
       plane_equation_coefficients.d = -lsf_results.D;
@@ -838,6 +845,29 @@ G29_TYPE GcodeSuite::G29() {
         SERIAL_EOL();
       }
 
+      #if ENABLED(LSF_ROBUST_FIT)
+        if (abl.verbose_level || lsf_res.outliers) {
+          report_LSF_residuals(lsf_res);
+          // List the rejected points so a dirty spot on the bed can be found
+          if (lsf_res.outliers) for (grid_count_t i = 0; i < abl.abl_points; ++i)
+            if (LSF_rejected(lsf_res, probe_x[i], probe_y[i], abl.eqnBVector[i]))
+              SERIAL_ECHOLNPGM("Rejected point X", probe_x[i], " Y", probe_y[i], " Z", abl.eqnBVector[i]);
+        }
+        #if ENABLED(LSF_QUADRATIC_REPORT)
+          if (abl.verbose_level > 2) {
+            quadratic_fit_data qsf;
+            lsf_residuals qsf_res;
+            if (!quadratic_LSF(&qsf, probe_x, probe_y, abl.eqnBVector, abl.abl_points, &qsf_res)) {
+              // The squared terms describe how much the bed is bowed or twisted over the probed area
+              SERIAL_ECHOPAIR_F("Quadratic fit bow X: ", qsf.c[3], 4);
+              SERIAL_ECHOPAIR_F(" Y: ", qsf.c[5], 4);
+              SERIAL_ECHOPAIR_F(" twist: ", qsf.c[4], 4);
+              SERIAL_ECHOLNPAIR_F(" rms: ", qsf_res.rms, 4);
+            }
+          }
+        #endif
+      #endif
+
       // Create the matrix but don't correct the position yet
       if (!abl.dryrun)
         planner.bed_level_matrix = matrix_3x3::create_look_at(
@@ -80,6 +80,7 @@
     // Pretend the current position is 0,0
     current_position.set(0.0, 0.0);
     sync_plan_position();
+    TERN_(ADAPTIVE_HOMING, axes_home_known &= ~(_BV(X_AXIS) | _BV(Y_AXIS))); // No longer relative to the last trigger
 
     const int x_axis_home_dir = TOOL_X_HOME_DIR(active_extruder);
 
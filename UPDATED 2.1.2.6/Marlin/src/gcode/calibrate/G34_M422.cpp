@@ -273,12 +273,24 @@ void GcodeSuite::G34() {
           // Calculate the Z position of each stepper and store it in z_measured.
           // This allows the actual adjustment logic to be shared by both algorithms.
           linear_fit_data lfd;
-          incremental_LSF_reset(&lfd);
-          for (uint8_t i = 0; i < NUM_Z_STEPPERS; ++i) {
-            SERIAL_ECHOLNPGM("PROBEPT_", i, ": ", z_measured[i]);
-            incremental_LSF(&lfd, z_stepper_align.xy[i], z_measured[i]);
-          }
-          finish_incremental_LSF(&lfd);
+          #if ENABLED(LSF_ROBUST_FIT)
+            float probe_x[NUM_Z_STEPPERS], probe_y[NUM_Z_STEPPERS];
+            for (uint8_t i = 0; i < NUM_Z_STEPPERS; ++i) {
+              SERIAL_ECHOLNPGM("PROBEPT_", i, ": ", z_measured[i]);
+              probe_x[i] = z_stepper_align.xy[i].x;
+              probe_y[i] = z_stepper_align.xy[i].y;
+            }
+            lsf_residuals lsf_res;
+            finish_robust_LSF(&lfd, probe_x, probe_y, z_measured, NUM_Z_STEPPERS, LSF_OUTLIER_THRESHOLD, &lsf_res);
+            report_LSF_residuals(lsf_res);
+          #else
+            incremental_LSF_reset(&lfd);
+            for (uint8_t i = 0; i < NUM_Z_STEPPERS; ++i) {
+              SERIAL_ECHOLNPGM("PROBEPT_", i, ": ", z_measured[i]);
+              incremental_LSF(&lfd, z_stepper_align.xy[i], z_measured[i]);
+            }
+            finish_incremental_LSF(&lfd);
+          #endif
 
           z_measured_min = 100000.0f;
           for (uint8_t i = 0; i < NUM_Z_STEPPERS; ++i) {
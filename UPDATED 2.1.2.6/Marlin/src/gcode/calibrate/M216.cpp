@@ -0,0 +1,57 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2024 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../../inc/MarlinConfig.h"
+
+#if ENABLED(ADAPTIVE_HOMING)
+
+#include "../gcode.h"
+#include "../../module/motion.h"
+
+/**
+ * M216: Report or clear the Adaptive Homing history
+ *
+ *   C      Clear the history, so homing runs the full bump cycle until it learns again
+ *   X Y Z  With C, clear only the given axes
+ *
+ * Use M500 to save the cleared history.
+ */
+void GcodeSuite::M216() {
+  if (parser.seen_test('C')) {
+    const bool all = !parser.seen_axis();
+    LOOP_NUM_AXES(a) if (a <= Z_AXIS && (all || parser.seen_test(AXIS_CHAR(a)))) {
+      homing_history.fast_offset[a] = 0;
+      homing_history.samples[a] = 0;
+    }
+  }
+
+  SERIAL_ECHO_START();
+  SERIAL_ECHOPGM("Adaptive homing:");
+  LOOP_NUM_AXES(a) if (a <= Z_AXIS) {
+    SERIAL_CHAR(' ', AXIS_CHAR(a));
+    SERIAL_ECHO(homing_history.fast_offset[a]);
+    SERIAL_ECHOPGM(" (", homing_history.samples[a], ")");
+  }
+  SERIAL_EOL();
+}
+
+#endif // ADAPTIVE_HOMING
@@ -27,12 +27,19 @@
 #include "../../gcode.h"
 #include "../../../module/stepper.h"
 
+#if ENABLED(SHAPING_AUTOTUNE)
+  #include "../../../feature/resonance_test.h"
+#endif
+
 void GcodeSuite::M593_report(const bool forReplay/*=true*/) {
   report_heading_etc(forReplay, F("Input Shaping"));
   #if ENABLED(INPUT_SHAPING_X)
     SERIAL_ECHOLNPGM("  M593 X"
       " F", stepper.get_shaping_frequency(X_AXIS),
       " D", stepper.get_shaping_damping_ratio(X_AXIS)
+      #if ENABLED(SHAPING_MULTI_IMPULSE)
+        , " T", int(stepper.get_shaping_type(X_AXIS))
+      #endif
     );
   #endif
   #if ENABLED(INPUT_SHAPING_Y)
@@ -40,15 +47,20 @@ void GcodeSuite::M593_report(const bool forReplay/*=true*/) {
     SERIAL_ECHOLNPGM("  M593 Y"
       " F", stepper.get_shaping_frequency(Y_AXIS),
       " D", stepper.get_shaping_damping_ratio(Y_AXIS)
+      #if ENABLED(SHAPING_MULTI_IMPULSE)
+        , " T", int(stepper.get_shaping_type(Y_AXIS))
+      #endif
     );
   #endif
 }
 
 /**
  * M593: Get or Set Input Shaping Parameters
+ *  A            Run a resonance test and recommend shaper settings (Requires SHAPING_AUTOTUNE).
+ *               Tests the given axes, or both X and Y. With S apply the recommendation.
  *  D<factor>    Set the zeta/damping factor. If axes (X, Y, etc.) are not specified, set for all axes.
  *  F<frequency> Set the frequency. If axes (X, Y, etc.) are not specified, set for all axes.
- *  T[map]       Input Shaping type, 0:ZV, 1:EI, 2:2H EI (not implemented yet)
+ *  T<type>      Set the shaper type (Requires SHAPING_MULTI_IMPULSE). 0:ZV, 1:ZVD, 2:MZV, 3:EI, 4:2HUMP_EI
  *  X            Set the given parameters only for the X axis.
  *  Y            Set the given parameters only for the Y axis.
  */
@@ -60,6 +72,15 @@ void GcodeSuite::M593() {
              for_X = seen_X || TERN0(INPUT_SHAPING_X, (!seen_X && !seen_Y)),
              for_Y = seen_Y || TERN0(INPUT_SHAPING_Y, (!seen_X && !seen_Y));
 
+  #if ENABLED(SHAPING_AUTOTUNE)
+    if (parser.seen_test('A')) {
+      const bool apply = parser.seen_test('S');
+      if (for_X) resonance_test.run(X_AXIS, apply);
+      if (for_Y) resonance_test.run(Y_AXIS, apply);
+      return;
+    }
+  #endif
+
   if (parser.seen('D')) {
     const float zeta = parser.value_float();
     if (WITHIN(zeta, 0, 1)) {
@@ -70,9 +91,21 @@ void GcodeSuite::M593() {
       SERIAL_ECHO_MSG("?Zeta (D) value out of range (0-1)");
   }
 
+  #if ENABLED(SHAPING_MULTI_IMPULSE)
+    if (parser.seen('T')) {
+      const uint8_t type = parser.value_byte();
+      if (type < SHAPER_COUNT) {
+        if (for_X) stepper.set_shaping_type(X_AXIS, ShapingType(type));
+        if (for_Y) stepper.set_shaping_type(Y_AXIS, ShapingType(type));
+      }
+      else
+        SERIAL_ECHO_MSG("?Shaper type (T) value out of range (0-", SHAPER_COUNT - 1, ")");
+    }
+  #endif
+
   if (parser.seen('F')) {
     const float freq = parser.value_float();
-    constexpr float min_freq = float(uint32_t(STEPPER_TIMER_RATE) / 2) / shaping_time_t(-2);
+    constexpr float min_freq = float(uint32_t(STEPPER_TIMER_RATE) / 2) * shaping_max_span / shaping_time_t(-2);
     if (freq == 0.0f || freq > min_freq) {
       if (for_X) stepper.set_shaping_frequency(X_AXIS, freq);
       if (for_Y) stepper.set_shaping_frequency(Y_AXIS, freq);
@@ -0,0 +1,46 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2024 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../../../inc/MarlinConfig.h"
+
+#if ENABLED(MOTION_TELEMETRY)
+
+#include "../../gcode.h"
+#include "../../queue.h"
+#include "../../../feature/motion_telemetry.h"
+
+/**
+ * M577: Stream binary motion telemetry to the host that sent this command
+ *
+ *  S<0|1> - Stop or start the stream, clearing the counters on start
+ *
+ *  With no parameters report the telemetry state and counters.
+ *  Decode the stream with buildroot/share/scripts/telemetry_decode.py
+ */
+void GcodeSuite::M577() {
+  if (parser.seen('S'))
+    motion_telemetry.enable(parser.value_bool() OPTARG(HAS_MULTI_SERIAL, queue.ring_buffer.command_port()));
+  else
+    motion_telemetry.report();
+}
+
+#endif // MOTION_TELEMETRY
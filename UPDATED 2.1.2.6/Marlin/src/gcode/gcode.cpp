@@ -740,6 +740,10 @@ void GcodeSuite::process_parsed_command(const bool no_ok/*=false*/) {
         case 211: M211(); break;                                  // M211: Enable, Disable, and/or Report software endstops
       #endif
 
+      #if ENABLED(ADAPTIVE_HOMING)
+        case 216: M216(); break;                                  // M216: Report or clear the adaptive homing history
+      #endif
+
       #if HAS_MULTI_EXTRUDER
         case 217: M217(); break;                                  // M217: Set filament swap parameters
       #endif
@@ -934,6 +938,10 @@ void GcodeSuite::process_parsed_command(const bool no_ok/*=false*/) {
         case 575: M575(); break;                                  // M575: Set serial baudrate
       #endif
 
+      #if ENABLED(MOTION_TELEMETRY)
+        case 577: M577(); break;                                  // M577: Stream motion telemetry
+      #endif
+
       #if HAS_ZV_SHAPING
         case 593: M593(); break;                                  // M593: Set Input Shaping parameters
       #endif
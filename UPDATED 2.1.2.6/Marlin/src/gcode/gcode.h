@@ -196,6 +196,7 @@
  * M209 - Turn Automatic Retract Detection on/off: S<0|1> (For slicers that don't support G10/11). (Requires FWRETRACT_AUTORETRACT)
           Every normal extrude-only move will be classified as retract depending on the direction.
  * M211 - Enable, Disable, and/or Report software endstops: S<0|1> (Requires MIN_SOFTWARE_ENDSTOPS or MAX_SOFTWARE_ENDSTOPS)
+ * M216 - Report or clear the adaptive homing history: "M216 C [X] [Y] [Z]". (Requires ADAPTIVE_HOMING)
  * M217 - Set filament swap parameters: "M217 S<length> P<feedrate> R<feedrate>". (Requires SINGLENOZZLE)
  * M218 - Set/get a tool offset: "M218 T<index> X<offset> Y<offset>". (Requires 2 or more extruders)
  * M220 - Set Feedrate Percentage: "M220 S<percent>" (i.e., "FR" on the LCD)
@@ -259,6 +260,7 @@
  * M554 - Get or set IP gateway. (Requires enabled Ethernet port)
  * M569 - Enable stealthChop on an axis. (Requires at least one _DRIVER_TYPE to be TMC2130/2160/2208/2209/5130/5160)
  * M575 - Change the serial baud rate. (Requires BAUD_RATE_GCODE)
+ * M577 - Stream binary motion telemetry: "M577 S<0|1>". (Requires MOTION_TELEMETRY)
  * M593 - Get or set input shaping parameters. (Requires INPUT_SHAPING_[XY])
  * M600 - Pause for filament change: "M600 X<pos> Y<pos> Z<raise> E<first_retract> L<later_retract>". (Requires ADVANCED_PAUSE_FEATURE)
  * M603 - Configure filament change: "M603 T<tool> U<unload_length> L<load_length>". (Requires ADVANCED_PAUSE_FEATURE)
@@ -873,6 +875,10 @@ private:
   static void M211();
   static void M211_report(const bool forReplay=true);
 
+  #if ENABLED(ADAPTIVE_HOMING)
+    static void M216();
+  #endif
+
   #if HAS_MULTI_EXTRUDER
     static void M217();
     static void M217_report(const bool forReplay=true);
@@ -1091,6 +1097,10 @@ private:
     static void M575();
   #endif
 
+  #if ENABLED(MOTION_TELEMETRY)
+    static void M577();
+  #endif
+
   #if HAS_ZV_SHAPING
     static void M593();
     static void M593_report(const bool forReplay=true);
@@ -30,6 +30,10 @@
   #include "queue.h"
 #endif
 
+#if ENABLED(CPU_PROFILER)
+  #include "../feature/cpu_profiler.h"
+#endif
+
 #include "../module/settings.h"
 #include "../module/temperature.h"
 #include "../libs/hex_print.h"
@@ -178,6 +182,29 @@ void GcodeSuite::D(const int16_t dcode) {
       SERIAL_ECHOLN(gtn(&SERIAL_IMPL));
       break;
 
+    #if ENABLED(CPU_PROFILER)
+
+      /**
+       * D8: Report CPU use by the profiled ISRs and idle() tasks
+       * Usage: D8 [R] [S<seconds>]
+       *
+       *   R : Reset the counters after the report
+       *   S : Auto-report every S seconds, resetting each time (S0 to stop)
+       *
+       * For each section prints the calls, min / avg / max cycles and
+       * the share of the CPU used since the counters were reset.
+       */
+      case 8:
+        if (parser.seenval('S')) {
+          cpu_profiler.reset();
+          cpu_profiler.auto_reporter.set_interval(parser.value_byte());
+        }
+        else
+          cpu_profiler.report(parser.seen_test('R'));
+        break;
+
+    #endif
+
     case 100: { // D100 Disable heaters and attempt a hard hang (Watchdog Test)
       SERIAL_ECHOLNPGM("Disabling heaters and attempting to trigger Watchdog");
       SERIAL_ECHOLNPGM("(USE_WATCHDOG " TERN(USE_WATCHDOG, "ENABLED", "DISABLED") ")");
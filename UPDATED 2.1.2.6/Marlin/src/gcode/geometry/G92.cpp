@@ -123,7 +123,10 @@ void GcodeSuite::G92() {
       coordinate_system[active_coordinate_system] = position_shift;
   #endif
 
-  if (sync_XYZE) sync_plan_position();
+  if (sync_XYZE) {
+    TERN_(ADAPTIVE_HOMING, axes_home_known = 0); // Adaptive homing can't predict from a new position
+    sync_plan_position();
+  }
   #if HAS_EXTRUDERS
     else if (sync_E) sync_plan_position_e();
   #endif
@@ -81,7 +81,7 @@ void GcodeSuite::M73() {
         SERIAL_ECHOPGM(" Progress: ", TERN(PRINT_PROGRESS_SHOW_DECIMALS, permyriadtostr4(ui.get_progress_permyriad()), ui.get_progress_percent()), "%;");
       #endif
       #if ENABLED(SET_REMAINING_TIME)
-        SERIAL_ECHOPGM(" Time left: ", ui.remaining_time / 60, "m;");
+        SERIAL_ECHOPGM(" Time left: ", TERN(SD_JOB_ESTIMATE, ui.get_remaining_time(), ui.remaining_time) / 60, "m;");
       #endif
       #if ENABLED(SET_INTERACTION_TIME)
         SERIAL_ECHOPGM(" Change: ", ui.interaction_time / 60, "m;");
@@ -49,6 +49,16 @@ GCodeQueue queue;
   #include "../feature/repeat.h"
 #endif
 
+#if HAS_MEDIA && ENABLED(CANCEL_OBJECTS) && ANY(SD_GCODE_INDEX, CANCEL_OBJECTS_SD_SKIP)
+  #include "../feature/gcode_index.h"
+  #include "../feature/cancel_object.h"
+  #define HAS_SD_OBJECT_SKIP 1
+#endif
+
+#if ENABLED(CPU_PROFILER)
+  #include "../feature/cpu_profiler.h"
+#endif
+
 // Frequently used G-code strings
 PGMSTR(G28_STR, "G28");
 
@@ -242,7 +252,10 @@ void GCodeQueue::RingBuffer::ok_to_send() {
     // Start counting from the last command's execution
     last_command_time = millis();
   #endif
-  CommandLine &command = commands[index_r];
+  ok_to_send(commands[index_r]);
+}
+
+void GCodeQueue::RingBuffer::ok_to_send(const CommandLine &command) {
   #if HAS_MULTI_SERIAL
     const serial_index_t serial_ind = command.port;
     if (!serial_ind.valid()) return;              // Optimization here, skip processing if it's not going anywhere
@@ -251,7 +264,7 @@ void GCodeQueue::RingBuffer::ok_to_send() {
   if (command.skip_ok) return;
   SERIAL_ECHOPGM(STR_OK);
   #if ENABLED(ADVANCED_OK)
-    char* p = command.buffer;
+    const char *p = command.buffer;
     if (*p == 'N') {
       SERIAL_CHAR(' ', *p++);
       while (NUMERIC_SIGNED(*p))
@@ -331,6 +344,13 @@ FORCE_INLINE bool is_M29(const char * const cmd) {  // matches "M29" & "M29 ", b
   return m29 && !NUMERIC(m29[3]);
 }
 
+#if ENABLED(OUT_OF_BAND_COMMANDS)
+  FORCE_INLINE bool is_M28(const char * const cmd) {
+    const char * const m28 = strstr_P(cmd, PSTR("M28"));
+    return m28 && !NUMERIC(m28[3]);
+  }
+#endif
+
 #define PS_NORMAL 0
 #define PS_EOL    1
 #define PS_QUOTED 2
@@ -566,14 +586,184 @@ void GCodeQueue::get_serial_commands() {
    * always receives complete command-lines, they can go directly
    * into the main command queue.
    */
+  #if HAS_SD_OBJECT_SKIP
+
+    enum : uint8_t { SKIP_E_MODE = _BV(0), SKIP_E = _BV(1), SKIP_F = _BV(2) };
+    static gcode_mark_t sd_skip_to;     // State after the skipped lines
+    static uint8_t sd_skip_pending;     // Commands still to queue for it
+
+    #if ENABLED(SD_GCODE_INDEX)
+
+      /**
+       * Go straight to the next object when the index has it and the object
+       * has only moves. The E mode, E position and feedrate that the skipped
+       * lines would have set are queued as commands before the next line.
+       */
+      inline bool jump_to_next_object(const int8_t obj) {
+        const gcode_mark_t * const from = gcode_index.object_start(card.getIndex());
+        if (!from || from->object != obj || !from->moves_only) return false;
+        const gcode_mark_t * const to = gcode_index.next_mark(from);
+        if (!to) return false;
+        card.setIndex(to->sdpos);
+        TERN_(POWER_LOSS_RECOVERY, recovery.cmd_sdpos = to->sdpos);
+        sd_skip_to = *to;
+        sd_skip_pending = (to->e_relative != from->e_relative ? SKIP_E_MODE : 0)
+                        | (to->e != from->e ? SKIP_E : 0)
+                        | (to->feedrate != from->feedrate ? SKIP_F : 0);
+        return true;
+      }
+
+    #endif
+
+    #if ENABLED(CANCEL_OBJECTS_SD_SKIP)
+
+      #define SD_SKIP_BYTES 2048          // Bytes to skip before going back to the main loop
+
+      static bool sd_skip_lines,          // The lines being read belong to a canceled object
+                  sd_fast_forward,        // Reading lines without queuing them
+                  sd_skip_e_relative;     // The E mode before the skipped lines
+
+      /**
+       * Start reading lines without queuing them. The E mode comes from the
+       * commands still in the queue, while E and F are only known once the
+       * skipped lines set them.
+       */
+      inline void start_fast_forward() {
+        GCodeQueue::RingBuffer &ring_buffer = GCodeQueue::ring_buffer;
+        sd_skip_to.e_relative = gcode.axis_is_relative(E_AXIS);
+        for (uint8_t i = ring_buffer.index_r, n = ring_buffer.length; n--; i = (i + 1) % BUFSIZE)
+          GcodeIndex::track(sd_skip_to, ring_buffer.commands[i].buffer);
+        sd_skip_e_relative = sd_skip_to.e_relative;
+        sd_skip_to.e = NAN;
+        sd_skip_to.feedrate = 0;
+        sd_fast_forward = true;
+      }
+
+      /**
+       * Skip the lines that the index could jump over: moves, comments, and changes
+       * to the tracked E state. Also skip the start of another canceled object.
+       */
+      inline bool skip_line(const char *cmd) {
+        const int8_t obj = GcodeIndex::m486_object(cmd);
+        if (obj >= -1) return obj >= 0 && cancelable.is_canceled(obj);
+        gcode_mark_t s = sd_skip_to;
+        if (GcodeIndex::track(s, cmd) == TRACK_RUN) return false;
+        sd_skip_to = s;
+        return true;
+      }
+
+      // Go back to the start of a line that has to run, after the commands for the skipped state
+      inline void stop_fast_forward(const uint32_t line_sdpos) {
+        sd_fast_forward = false;
+        card.setIndex(line_sdpos);
+        TERN_(POWER_LOSS_RECOVERY, recovery.cmd_sdpos = line_sdpos);
+        sd_skip_pending = (sd_skip_to.e_relative != sd_skip_e_relative ? SKIP_E_MODE : 0)
+                        | (!sd_skip_to.e_relative && !isnan(sd_skip_to.e) ? SKIP_E : 0)
+                        | (sd_skip_to.feedrate ? SKIP_F : 0);
+      }
+
+      /**
+       * Read lines of a canceled object without queuing them, keeping the E position
+       * and feedrate they set. Return to the main loop after a whole line once enough
+       * has been read, to keep the planner fed.
+       */
+      inline void fast_forward(char (&buff)[MAX_CMD_SIZE]) {
+        uint8_t sis = PS_NORMAL;
+        int count = 0;
+        uint32_t line_sdpos = card.getIndex();
+        for (uint16_t bytes = 0; bytes < SD_SKIP_BYTES || card.getIndex() != line_sdpos; ++bytes) {
+          const int16_t n = card.get();
+          const bool card_eof = card.eof();
+          if (n < 0 && !card_eof) return stop_fast_forward(line_sdpos); // Leave read errors to the normal path
+
+          const char sd_char = (char)n;
+          if (ISEOL(sd_char)) {
+            if (!process_line_done(sis, buff, count) && !skip_line(buff))
+              return stop_fast_forward(line_sdpos);
+            if (card_eof) {                             // Skipped to the end
+              sd_fast_forward = false;
+              sd_skip_pending = 0;
+              card.fileHasFinished();
+              return;
+            }
+            line_sdpos = card.getIndex();
+          }
+          else if (card_eof)                            // A last line with no newline
+            return stop_fast_forward(line_sdpos);
+          else
+            process_stream_char(sd_char, sis, buff, count);
+        }
+      }
+
+    #endif // CANCEL_OBJECTS_SD_SKIP
+
+    /**
+     * After "M486 S" for a canceled object skip its lines in the reader,
+     * so they aren't queued and parsed only to be dropped. The index jump
+     * is only taken for an object with nothing but moves, where it gives
+     * the same result as reading up to the next object. Otherwise the lines
+     * are read, and the first one that has to run is queued as usual.
+     */
+    inline void skip_canceled_object(const char * const cmd) {
+      const int8_t obj = GcodeIndex::m486_object(cmd);
+      #if ENABLED(CANCEL_OBJECTS_SD_SKIP)
+        if (obj >= -1) sd_skip_lines = obj >= 0 && cancelable.is_canceled(obj);
+      #endif
+      #if ENABLED(SD_GCODE_INDEX)
+        if (obj >= 0 && cancelable.is_canceled(obj) && jump_to_next_object(obj)) return;
+      #endif
+      TERN_(CANCEL_OBJECTS_SD_SKIP, if (sd_skip_lines) start_fast_forward());
+    }
+
+    // Queue one of the commands for the state after skipped lines
+    inline void queue_skip_state() {
+      GCodeQueue::RingBuffer &ring_buffer = GCodeQueue::ring_buffer;
+      char * const cmd = ring_buffer.commands[ring_buffer.index_w].buffer;
+      if (sd_skip_pending & SKIP_E_MODE) {
+        sd_skip_pending &= ~SKIP_E_MODE;
+        strcpy_P(cmd, sd_skip_to.e_relative ? PSTR("M83") : PSTR("M82"));
+      }
+      else if (sd_skip_pending & SKIP_E) {
+        sd_skip_pending &= ~SKIP_E;
+        char str_1[16];
+        sprintf_P(cmd, PSTR("G92E%s"), dtostrf(sd_skip_to.e, 1, 5, str_1));
+      }
+      else {
+        sd_skip_pending = 0;
+        sprintf_P(cmd, PSTR("G1F%u"), sd_skip_to.feedrate);
+      }
+      ring_buffer.commit_command(true);
+    }
+
+  #endif // HAS_SD_OBJECT_SKIP
+
   inline void GCodeQueue::get_sdcard_commands() {
     static uint8_t sd_input_state = PS_NORMAL;
 
     // Get commands if there are more in the file
-    if (!IS_SD_FETCHING()) return;
+    if (!IS_SD_FETCHING()) {
+      #if HAS_SD_OBJECT_SKIP
+        if (!IS_SD_FILE_OPEN()) {                       // Forget skips from an ended print
+          sd_skip_pending = 0;
+          TERN_(CANCEL_OBJECTS_SD_SKIP, sd_skip_lines = sd_fast_forward = false);
+        }
+      #endif
+      return;
+    }
 
     int sd_count = 0;
     while (!ring_buffer.full() && !card.eof()) {
+      #if HAS_SD_OBJECT_SKIP
+        if (sd_skip_pending) { queue_skip_state(); continue; }
+        #if ENABLED(CANCEL_OBJECTS_SD_SKIP)
+          if (sd_fast_forward) {
+            fast_forward(ring_buffer.commands[ring_buffer.index_w].buffer);
+            if (sd_fast_forward) break;                 // More to skip on the next loop
+            continue;
+          }
+        #endif
+      #endif
+
       const int16_t n = card.get();
       const bool card_eof = card.eof();
       if (n < 0 && !card_eof) { SERIAL_ERROR_MSG(STR_SD_ERR_READ); continue; }
@@ -602,6 +792,9 @@ void GCodeQueue::get_serial_commands() {
 
           // Prime Power-Loss Recovery for the NEXT commit_command
           TERN_(POWER_LOSS_RECOVERY, recovery.cmd_sdpos = card.getIndex());
+
+          // Skip a canceled object without reading it
+          TERN_(HAS_SD_OBJECT_SKIP, skip_canceled_object(command.buffer));
         }
 
         if (card.eof()) card.fileHasFinished();         // Handle end of file reached
@@ -639,6 +832,11 @@ void GCodeQueue::exhaust() {
  * Get the next command in the queue, optionally log it to SD, then dispatch it
  */
 void GCodeQueue::advance() {
+  TERN_(CPU_PROFILER, PROFILE_SCOPE(QUEUE_ADVANCE));
+
+  #if ENABLED(OUT_OF_BAND_COMMANDS)
+    REMEMBER(busy, in_command, IN_INJECTED); // Let idle() run status commands while a command waits
+  #endif
 
   // Process immediate commands
   if (process_injected_command_P() || process_injected_command()) return;
@@ -663,6 +861,8 @@ void GCodeQueue::advance() {
     }
   #endif
 
+  TERN_(OUT_OF_BAND_COMMANDS, in_command = IN_QUEUED); // The command at the head of the queue runs
+
   #if HAS_MEDIA
 
     if (card.flag.saving) {
@@ -705,6 +905,84 @@ void GCodeQueue::advance() {
   ring_buffer.advance_r();
 }
 
+#if ENABLED(OUT_OF_BAND_COMMANDS)
+
+  GCodeQueue::InCommand GCodeQueue::in_command; // = IN_NONE
+
+  /**
+   * Remove a command that was run out of order,
+   * moving the commands after it down by one.
+   */
+  void GCodeQueue::RingBuffer::remove(uint8_t i) {
+    for (;;) {
+      const uint8_t n = i + 1 < BUFSIZE ? i + 1 : 0;
+      if (n == index_w) break;
+      commands[i] = commands[n];
+      i = n;
+    }
+    index_w = i;
+    length--;
+  }
+
+  /**
+   * Status and emergency commands that are safe to run while
+   * another command handler is waiting: M27, M31, M105, M114
+   * (without parameters) and, when EMERGENCY_PARSER isn't there
+   * to catch them, M108, M112 and M410.
+   */
+  static bool is_out_of_band(const char *cmd) {
+    if (*cmd == 'N') {                              // Skip the line number
+      while (*cmd && *cmd != ' ') cmd++;
+      while (*cmd == ' ') cmd++;
+    }
+    if (*cmd++ != 'M' || !NUMERIC(*cmd)) return false;
+    const int codenum = atoi(cmd);
+    while (NUMERIC(*cmd)) cmd++;
+    if (*cmd == '.') return false;                  // No subcodes
+    switch (codenum) {
+      case 27: case 31: case 105:
+      #if DISABLED(EMERGENCY_PARSER)
+        case 108: case 112: case 410:
+      #endif
+        return true;
+      case 114:                                     // M114 D, E, and R wait for moves
+        while (*cmd == ' ') cmd++;
+        return !*cmd || *cmd == '*';
+    }
+    return false;
+  }
+
+  void GCodeQueue::process_out_of_band() {
+    static bool running; // = false
+    const bool skip_head = (in_command == IN_QUEUED); // The head of the queue is the running command
+    if (!in_command || running || ring_buffer.length <= skip_head || TERN0(HAS_MEDIA, card.flag.saving)) return;
+
+    uint8_t i = ring_buffer.index_r;
+    if (!skip_head) i = (i ? i : BUFSIZE) - 1;         // Start the scan at the head
+    for (uint8_t n = ring_buffer.length - skip_head; n--;) {
+      if (++i >= BUFSIZE) i = 0;
+      CommandLine &command = ring_buffer.commands[i];
+      if (TERN0(HAS_MEDIA, is_M28(command.buffer))) break;  // Lines after M28 go to a file
+      if (command.skip_ok || !is_out_of_band(command.buffer)) continue;  // Only from the host
+
+      running = true;
+      char * const saved_cmd = parser.command_ptr;          // Save the parser state
+      {
+        PORT_REDIRECT(SERIAL_PORTMASK(command.port));
+        parser.parse(command.buffer);
+        const bool is_M105 = parser.is_command('M', 105);   // M105 says "ok" itself
+        gcode.process_parsed_command(true);
+        if (!is_M105) ring_buffer.ok_to_send(command);
+      }
+      parser.parse(saved_cmd);                              // Restore the parser state
+      ring_buffer.remove(i);
+      running = false;
+      break;                                                // One command per call
+    }
+  }
+
+#endif // OUT_OF_BAND_COMMANDS
+
 #if ENABLED(BUFFER_MONITORING)
 
   void GCodeQueue::report_buffer_statistics() {
@@ -90,6 +90,11 @@ public:
     );
 
     void ok_to_send();
+    void ok_to_send(const CommandLine &command);
+
+    #if ENABLED(OUT_OF_BAND_COMMANDS)
+      void remove(uint8_t i);
+    #endif
 
     inline bool full(uint8_t cmdCount=1) const { return length > (BUFSIZE - cmdCount); }
 
@@ -173,6 +178,16 @@ public:
    */
   static void advance();
 
+  #if ENABLED(OUT_OF_BAND_COMMANDS)
+    /**
+     * Run one queued status or emergency command while the current
+     * command handler is waiting. Called from idle().
+     */
+    enum InCommand : uint8_t { IN_NONE, IN_INJECTED, IN_QUEUED };
+    static InCommand in_command;    // The kind of command whose handler is running
+    static void process_out_of_band();
+  #endif
+
   /**
    * Run the entire queue in-place
    */
@@ -38,14 +38,23 @@
  *
  * With M20_TIMESTAMP_SUPPORT:
  *   T<bool> - Include timestamps
+ *
+ * With M20_PAGINATION:
+ *   R<index> - First file to list, counting from 0
+ *   C<count> - Maximum number of files to list
+ *   If files remain, "File list continues at R<index>" follows the list.
  */
 void GcodeSuite::M20() {
   if (card.flag.mounted) {
     SERIAL_ECHOLNPGM(STR_BEGIN_FILE_LIST);
-    card.ls(TERN0(CUSTOM_FIRMWARE_UPLOAD,     parser.boolval('F') << LS_ONLY_BIN)
-          | TERN0(LONG_FILENAME_HOST_SUPPORT, parser.boolval('L') << LS_LONG_FILENAME)
-          | TERN0(M20_TIMESTAMP_SUPPORT,      parser.boolval('T') << LS_TIMESTAMP));
+    const uint16_t next = card.ls(
+        TERN0(CUSTOM_FIRMWARE_UPLOAD,     parser.boolval('F') << LS_ONLY_BIN)
+      | TERN0(LONG_FILENAME_HOST_SUPPORT, parser.boolval('L') << LS_LONG_FILENAME)
+      | TERN0(M20_TIMESTAMP_SUPPORT,      parser.boolval('T') << LS_TIMESTAMP)
+      OPTARG(M20_PAGINATION, parser.ushortval('R'), parser.ushortval('C'))
+    );
     SERIAL_ECHOLNPGM(STR_END_FILE_LIST);
+    if (next) SERIAL_ECHOLNPGM(STR_FILE_LIST_CONTINUES, next);
   }
   else
     SERIAL_ECHO_MSG(STR_NO_MEDIA);
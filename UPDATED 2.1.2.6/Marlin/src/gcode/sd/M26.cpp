@@ -27,12 +27,33 @@
 #include "../gcode.h"
 #include "../../sd/cardreader.h"
 
+#if ENABLED(SD_GCODE_INDEX)
+  #include "../../feature/gcode_index.h"
+#endif
+
 /**
  * M26: Set SD Card file index
+ *
+ *  S<index> : File position to read next
+ *  L<layer> : Go to the start of a layer, restoring E and feedrate (Requires SD_GCODE_INDEX)
  */
 void GcodeSuite::M26() {
-  if (card.isMounted() && parser.seenval('S'))
+  if (!card.isMounted()) return;
+
+  if (parser.seenval('S'))
     card.setIndex(parser.value_long());
+
+  #if ENABLED(SD_GCODE_INDEX)
+    else if (parser.seenval('L')) {
+      const gcode_mark_t * const m = gcode_index.layer(parser.value_ushort());
+      if (m) {
+        card.setIndex(m->sdpos);
+        gcode_index.apply(*m);
+      }
+      else
+        SERIAL_ECHO_MSG("Layer not indexed.");
+    }
+  #endif
 }
 
 #endif // HAS_MEDIA
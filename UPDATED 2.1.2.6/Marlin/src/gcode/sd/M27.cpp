@@ -27,10 +27,16 @@
 #include "../gcode.h"
 #include "../../sd/cardreader.h"
 
+#if ENABLED(SD_JOB_ESTIMATE)
+  #include "../../feature/job_estimate.h"
+#endif
+
 /**
  * M27: Get SD Card status
  *      OR, with 'S<seconds>' set the SD status auto-report interval. (Requires AUTO_REPORT_SD_STATUS)
  *      OR, with 'C' get the current filename.
+ *      OR, with 'E' get the estimate for the current file. (Requires SD_JOB_ESTIMATE)
+ *          'E2' also lists the time and max feedrate for each part of the file.
  */
 void GcodeSuite::M27() {
   if (parser.seen_test('C')) {
@@ -39,6 +45,13 @@ void GcodeSuite::M27() {
     return;
   }
 
+  #if ENABLED(SD_JOB_ESTIMATE)
+    if (parser.seen('E')) {
+      job_estimate.report(parser.value_byte() == 2);
+      return;
+    }
+  #endif
+
   #if ENABLED(AUTO_REPORT_SD_STATUS)
     if (parser.seenval('S')) {
       card.auto_reporter.set_interval(parser.value_byte());
@@ -858,6 +858,13 @@
   #define HAS_MEDIA_SUBCALLS 1
 #endif
 
+#if HAS_MEDIA && ANY(SD_GCODE_INDEX, CANCEL_OBJECTS_SD_SKIP, SD_JOB_ESTIMATE)
+  #define HAS_GCODE_TRACKING 1
+  #if ANY(SD_GCODE_INDEX, SD_JOB_ESTIMATE)
+    #define HAS_GCODE_SCAN 1
+  #endif
+#endif
+
 #if HAS_PRINT_PROGRESS && ANY(PRINT_PROGRESS_SHOW_DECIMALS, SHOW_REMAINING_TIME)
   #define HAS_PRINT_PROGRESS_PERMYRIAD 1
 #endif
@@ -1231,7 +1238,7 @@
 #endif
 
 // Flag whether least_squares_fit.cpp is used
-#if ANY(AUTO_BED_LEVELING_UBL, AUTO_BED_LEVELING_LINEAR, HAS_Z_STEPPER_ALIGN_STEPPER_XY)
+#if ANY(AUTO_BED_LEVELING_UBL, AUTO_BED_LEVELING_LINEAR, HAS_Z_STEPPER_ALIGN_STEPPER_XY) || ALL(LSF_ROBUST_FIT, ASSISTED_TRAMMING)
   #define NEED_LSF 1
 #endif
 
@@ -1286,4 +1293,23 @@
 // Input shaping
 #if ANY(INPUT_SHAPING_X, INPUT_SHAPING_Y)
   #define HAS_ZV_SHAPING 1
+  #ifndef SHAPING_TYPE_X
+    #define SHAPING_TYPE_X 0
+  #endif
+  #ifndef SHAPING_TYPE_Y
+    #define SHAPING_TYPE_Y 0
+  #endif
+  #if DISABLED(SHAPING_TRAPEZOID)
+    #define HAS_SHAPING_ECHOES 1
+    #if ENABLED(INPUT_SHAPING_X)
+      #define HAS_SHAPING_ECHO_X 1
+    #endif
+    #if ENABLED(INPUT_SHAPING_Y)
+      #define HAS_SHAPING_ECHO_Y 1
+    #endif
+  #endif
+#else
+  #undef SHAPING_MULTI_IMPULSE
+  #undef SHAPING_TRAPEZOID
+  #undef SHAPING_AUTOTUNE
 #endif
@@ -283,6 +283,12 @@
   #undef LCD_BED_TRAMMING
   #undef SLOWDOWN
 #endif
+#if DISABLED(SLOWDOWN)
+  #undef SLOWDOWN_ADAPTIVE
+#endif
+#if ANY(HAS_WIRED_LCD, SLOWDOWN_ADAPTIVE)
+  #define HAS_BLOCK_RUNTIME 1         // Track the time of the queued blocks
+#endif
 
 /**
  * SCARA cannot use SLOWDOWN and requires QUICKHOME
@@ -559,7 +565,9 @@
   #endif
 
   #if DISABLED(USB_FLASH_DRIVE_SUPPORT) || ALL(MULTI_VOLUME, VOLUME_SD_ONBOARD)
-    #if ENABLED(ONBOARD_SDIO)
+    #if ENABLED(SD_IMAGE_DRIVER)
+      #define NEED_SD2CARD_FILE 1
+    #elif ENABLED(ONBOARD_SDIO)
       #define NEED_SD2CARD_SDIO 1
     #else
       #define NEED_SD2CARD_SPI 1
@@ -2459,7 +2467,7 @@
 #if !HAS_TEMP_SENSOR
   #undef AUTO_REPORT_TEMPERATURES
 #endif
-#if ANY(AUTO_REPORT_TEMPERATURES, AUTO_REPORT_SD_STATUS, AUTO_REPORT_POSITION, AUTO_REPORT_FANS)
+#if ANY(AUTO_REPORT_TEMPERATURES, AUTO_REPORT_SD_STATUS, AUTO_REPORT_POSITION, AUTO_REPORT_FANS, CPU_PROFILER)
   #define HAS_AUTO_REPORTING 1
 #endif
 
@@ -447,6 +447,98 @@ static_assert(COUNT(arm) == LOGICAL_AXES, "AXIS_RELATIVE_MODES must contain " _L
   #endif
 #endif
 
+/**
+ * SD Extent Cache
+ */
+#if ENABLED(SD_EXTENT_CACHE) && !WITHIN(SD_EXTENT_COUNT, 1, 255)
+  #error "SD_EXTENT_COUNT must be between 1 and 255."
+#endif
+
+/**
+ * SD Stream Reads
+ */
+#if ENABLED(SD_STREAM_READS) && NEED_SD2CARD_SDIO
+  #error "SD_STREAM_READS requires an SPI-attached SD card."
+#endif
+
+/**
+ * SD Listing Cache
+ */
+#if ENABLED(SD_LISTING_CACHE) && !WITHIN(SD_LISTING_CACHE_SIZE, 256, 16384)
+  #error "SD_LISTING_CACHE_SIZE must be between 256 and 16384."
+#endif
+
+/**
+ * SD Write Behind
+ */
+#if ENABLED(SD_WRITE_BEHIND)
+  #if !WITHIN(SD_WRITE_BEHIND_BLOCKS, 2, 16)
+    #error "SD_WRITE_BEHIND_BLOCKS must be between 2 and 16."
+  #elif !WITHIN(SD_WRITE_PREALLOCATE, 1, 64)
+    #error "SD_WRITE_PREALLOCATE must be between 1 and 64."
+  #elif ENABLED(SDCARD_READONLY)
+    #error "SD_WRITE_BEHIND is not compatible with SDCARD_READONLY."
+  #endif
+#endif
+
+/**
+ * SD G-code Index
+ */
+#if ENABLED(SD_GCODE_INDEX)
+  #if !HAS_MEDIA
+    #error "SD_GCODE_INDEX requires SDSUPPORT."
+  #elif !HAS_EXTRUDERS
+    #error "SD_GCODE_INDEX requires an extruder."
+  #elif !WITHIN(SD_GCODE_INDEX_LAYERS, 16, 10000)
+    #error "SD_GCODE_INDEX_LAYERS must be between 16 and 10000."
+  #elif !WITHIN(SD_GCODE_INDEX_OBJECTS, 8, 1000)
+    #error "SD_GCODE_INDEX_OBJECTS must be between 8 and 1000."
+  #elif defined(__AVR__)
+    #error "SD_GCODE_INDEX needs more SRAM than AVR provides."
+  #endif
+#endif
+
+/**
+ * SD Job Estimate
+ */
+#if ENABLED(SD_JOB_ESTIMATE)
+  #if !HAS_MEDIA
+    #error "SD_JOB_ESTIMATE requires SDSUPPORT."
+  #elif !HAS_EXTRUDERS
+    #error "SD_JOB_ESTIMATE requires an extruder."
+  #elif !WITHIN(SD_JOB_ESTIMATE_REGIONS, 10, 250)
+    #error "SD_JOB_ESTIMATE_REGIONS must be between 10 and 250."
+  #elif defined(__AVR__)
+    #error "SD_JOB_ESTIMATE needs more SRAM than AVR provides."
+  #endif
+#endif
+
+#if ENABLED(CANCEL_OBJECTS_SD_SKIP)
+  #if !HAS_MEDIA
+    #error "CANCEL_OBJECTS_SD_SKIP requires SDSUPPORT."
+  #elif !HAS_EXTRUDERS
+    #error "CANCEL_OBJECTS_SD_SKIP requires an extruder."
+  #endif
+#endif
+
+/**
+ * SD Image Driver
+ */
+#if ENABLED(SD_IMAGE_DRIVER)
+  #ifndef __PLAT_LINUX__
+    #error "SD_IMAGE_DRIVER requires the linux_native environment."
+  #elif !NEED_SD2CARD_FILE
+    #error "SD_IMAGE_DRIVER requires SDSUPPORT."
+  #endif
+#endif
+
+/**
+ * SD Directory Index
+ */
+#if ENABLED(SD_DIR_INDEX) && !WITHIN(SD_DIR_INDEX_SIZE, 8, 1024)
+  #error "SD_DIR_INDEX_SIZE must be between 8 and 1024."
+#endif
+
 /**
  * Custom Event G-code
  */
@@ -487,6 +579,8 @@ static_assert(COUNT(arm) == LOGICAL_AXES, "AXIS_RELATIVE_MODES must contain " _L
     #error "BABYSTEP_HOTEND_Z_OFFSET requires 2 or more HOTENDS."
   #elif ALL(BABYSTEP_ALWAYS_AVAILABLE, MOVE_Z_WHEN_IDLE)
     #error "BABYSTEP_ALWAYS_AVAILABLE and MOVE_Z_WHEN_IDLE are incompatible."
+  #elif ENABLED(BABYSTEP_SMOOTH) && ANY(DELTA, CORE_IS_XZ, CORE_IS_YZ)
+    #error "BABYSTEP_SMOOTH requires Z to have its own stepper(s)."
   #elif !defined(BABYSTEP_MULTIPLICATOR_Z)
     #error "BABYSTEPPING requires BABYSTEP_MULTIPLICATOR_Z."
   #elif ENABLED(BABYSTEP_XY) && !defined(BABYSTEP_MULTIPLICATOR_XY)
@@ -824,6 +918,12 @@ static_assert(COUNT(arm) == LOGICAL_AXES, "AXIS_RELATIVE_MODES must contain " _L
   #elif NONE(HAS_JUNCTION_DEVIATION, ALLOW_LOW_EJERK) && defined(DEFAULT_EJERK)
     static_assert(DEFAULT_EJERK >= 10, "It is strongly recommended to set DEFAULT_EJERK >= 10 when using LIN_ADVANCE. Enable ALLOW_LOW_EJERK to bypass this alert (e.g., for direct drive).");
   #endif
+
+  #if ENABLED(SMOOTH_LIN_ADVANCE)
+    static_assert(WITHIN(LIN_ADVANCE_SMOOTH_TIME, 0.005, 0.2), "LIN_ADVANCE_SMOOTH_TIME must be from 0.005 to 0.2 seconds.");
+  #endif
+#elif ENABLED(SMOOTH_LIN_ADVANCE)
+  #error "SMOOTH_LIN_ADVANCE requires LIN_ADVANCE."
 #endif
 
 /**
@@ -2337,6 +2437,34 @@ static_assert(COUNT(arm) == LOGICAL_AXES, "AXIS_RELATIVE_MODES must contain " _L
   #error "ENDSTOP_NOISE_THRESHOLD must be an integer from 2 to 7."
 #endif
 
+/**
+ * Adaptive Homing
+ */
+#if ENABLED(ADAPTIVE_HOMING)
+  #if IS_KINEMATIC
+    #error "ADAPTIVE_HOMING is not compatible with DELTA, SCARA, TPARA, or POLARGRAPH."
+  #elif ENABLED(DUAL_X_CARRIAGE)
+    #error "ADAPTIVE_HOMING is not compatible with DUAL_X_CARRIAGE."
+  #endif
+  static_assert(ADAPTIVE_HOMING_TOLERANCE > 0, "ADAPTIVE_HOMING_TOLERANCE must be greater than 0.");
+  static_assert(WITHIN(ADAPTIVE_HOMING_SAMPLES, 1, 255), "ADAPTIVE_HOMING_SAMPLES must be from 1 to 255.");
+  static_assert(ADAPTIVE_HOMING_APPROACH_MM > 0, "ADAPTIVE_HOMING_APPROACH_MM must be greater than 0.");
+  static_assert(WITHIN(ADAPTIVE_HOMING_SPEEDUP, 1, 4), "ADAPTIVE_HOMING_SPEEDUP must be from 1 to 4.");
+#endif
+
+/**
+ * Endstop Input Capture
+ */
+#if ENABLED(ENDSTOP_INPUT_CAPTURE)
+  #ifndef __STM32F1__
+    #error "ENDSTOP_INPUT_CAPTURE is only supported on STM32F1."
+  #elif DISABLED(ENDSTOP_INTERRUPTS_FEATURE)
+    #error "ENDSTOP_INPUT_CAPTURE requires ENDSTOP_INTERRUPTS_FEATURE."
+  #elif defined(ENDSTOP_NOISE_THRESHOLD)
+    #error "ENDSTOP_INPUT_CAPTURE is incompatible with ENDSTOP_NOISE_THRESHOLD."
+  #endif
+#endif
+
 /**
  * Emergency Command Parser
  */
@@ -2377,6 +2505,31 @@ static_assert(COUNT(arm) == LOGICAL_AXES, "AXIS_RELATIVE_MODES must contain " _L
   #error "ASSISTED_TRAMMING requires a bed probe."
 #endif
 
+/**
+ * Inverse Kinematics Extrapolation
+ */
+#if ENABLED(IK_EXTRAPOLATION)
+  #if !IS_KINEMATIC
+    #error "IK_EXTRAPOLATION requires DELTA, SCARA, TPARA, or POLARGRAPH kinematics."
+  #endif
+  static_assert(WITHIN(IK_EXACT_INTERVAL, TERN(DELTA, 2, 6), 32), "IK_EXACT_INTERVAL must be between " TERN(DELTA, "2", "6") " and 32.");
+  static_assert(IK_EXTRAPOLATION_TOLERANCE > 0, "IK_EXTRAPOLATION_TOLERANCE must be greater than 0.");
+#endif
+
+/**
+ * Robust Least-Squares Fit
+ */
+#if ENABLED(LSF_ROBUST_FIT)
+  #if NONE(AUTO_BED_LEVELING_LINEAR, HAS_Z_STEPPER_ALIGN_STEPPER_XY, ASSISTED_TRAMMING)
+    #error "LSF_ROBUST_FIT requires AUTO_BED_LEVELING_LINEAR, Z_STEPPER_ALIGN_STEPPER_XY, or ASSISTED_TRAMMING."
+  #endif
+  static_assert(LSF_OUTLIER_THRESHOLD > 0, "LSF_OUTLIER_THRESHOLD must be greater than 0.");
+  static_assert(WITHIN(LSF_RANSAC_ITERATIONS, 1, 255), "LSF_RANSAC_ITERATIONS must be between 1 and 255.");
+  #if ENABLED(LSF_QUADRATIC_REPORT) && DISABLED(AUTO_BED_LEVELING_LINEAR)
+    #error "LSF_QUADRATIC_REPORT requires AUTO_BED_LEVELING_LINEAR."
+  #endif
+#endif
+
 /**
  * G38 Probe Target
  */
@@ -2578,6 +2731,14 @@ static_assert(COUNT(arm) == LOGICAL_AXES, "AXIS_RELATIVE_MODES must contain " _L
   #error "TFT_(COLOR|CLASSIC|LVGL)_UI requires a TFT display to be enabled."
 #endif
 
+#if ENABLED(TFT_DOUBLE_BUFFER)
+  #if DISABLED(TFT_COLOR_UI)
+    #error "TFT_DOUBLE_BUFFER requires TFT_COLOR_UI."
+  #elif ENABLED(TFT_SHARED_IO)
+    #error "TFT_DOUBLE_BUFFER is not compatible with TFT_SHARED_IO."
+  #endif
+#endif
+
 #if ENABLED(TFT_GENERIC) && NONE(TFT_INTERFACE_FSMC, TFT_INTERFACE_SPI)
   #error "TFT_GENERIC requires either TFT_INTERFACE_FSMC or TFT_INTERFACE_SPI interface."
 #elif ALL(TFT_INTERFACE_FSMC, TFT_INTERFACE_SPI)
@@ -3389,6 +3550,8 @@ static_assert(_PLUS_TEST(3), "DEFAULT_MAX_ACCELERATION values must be positive."
     #error "POWER_LOSS_RECOVER_ZHOME is not needed on a machine that homes to ZMAX."
   #elif ALL(IS_CARTESIAN, POWER_LOSS_RECOVER_ZHOME) && Z_HOME_TO_MIN && !defined(POWER_LOSS_ZHOME_POS)
     #error "POWER_LOSS_RECOVER_ZHOME requires POWER_LOSS_ZHOME_POS for a Cartesian that homes to ZMIN."
+  #elif ENABLED(POWER_LOSS_JOURNAL) && !WITHIN(POWER_LOSS_JOURNAL_BLOCKS, 8, 255)
+    #error "POWER_LOSS_JOURNAL_BLOCKS must be between 8 and 255."
   #endif
 #endif
 
@@ -3705,6 +3868,43 @@ static_assert(_PLUS_TEST(3), "DEFAULT_MAX_ACCELERATION values must be positive."
   #error "Either enable MEATPACK_ON_SERIAL_PORT_* or BINARY_FILE_TRANSFER, not both."
 #endif
 
+/**
+ * Sanity Check for ST7920 partial refresh
+ */
+#if ENABLED(ST7920_DIFF_REFRESH)
+  #if !IS_U8GLIB_ST7920
+    #error "ST7920_DIFF_REFRESH requires a U8GLIB_ST7920-based display."
+  #elif ENABLED(LIGHTWEIGHT_UI)
+    #error "ST7920_DIFF_REFRESH is not compatible with LIGHTWEIGHT_UI."
+  #elif LCD_PIXEL_WIDTH != 128 || LCD_PIXEL_HEIGHT != 64
+    #error "ST7920_DIFF_REFRESH requires a 128x64 display."
+  #endif
+  static_assert(WITHIN(ST7920_DIFF_BUDGET_MS, 0, 50), "ST7920_DIFF_BUDGET_MS must be from 0 to 50.");
+#endif
+
+/**
+ * Sanity Check for Adaptive Slowdown
+ */
+#if ENABLED(SLOWDOWN_ADAPTIVE)
+  static_assert(WITHIN(SLOWDOWN_RESERVE_MS, 20, 2000), "SLOWDOWN_RESERVE_MS must be from 20 to 2000.");
+  static_assert(WITHIN(SLOWDOWN_MIN_FACTOR, 0.05, 1.0), "SLOWDOWN_MIN_FACTOR must be from 0.05 to 1.0.");
+#endif
+
+/**
+ * Sanity Check for CPU Profiler
+ */
+#if ENABLED(CPU_PROFILER) && !defined(__PLAT_LINUX__) && (!defined(__arm__) || defined(__ARM_ARCH_6M__))
+  #error "CPU_PROFILER requires a Cortex-M3/M4/M7 (DWT cycle counter) or linux_native."
+#endif
+
+/**
+ * Sanity Check for Motion Telemetry
+ */
+#if ENABLED(MOTION_TELEMETRY)
+  static_assert(WITHIN(MOTION_TELEMETRY_RECORDS, 8, 128) && !(MOTION_TELEMETRY_RECORDS & (MOTION_TELEMETRY_RECORDS - 1)),
+    "MOTION_TELEMETRY_RECORDS must be a power of 2 from 8 to 128.");
+#endif
+
 /**
  * Sanity Check for Slim LCD Menus and Probe Offset Wizard
  */
@@ -3871,7 +4071,39 @@ static_assert(_PLUS_TEST(3), "DEFAULT_MAX_ACCELERATION values must be positive."
     #else
       static_assert(SHAPING_FREQ_X == SHAPING_FREQ_Y, "SHAPING_FREQ_X and SHAPING_FREQ_Y must be the same for COREXY / COREYX / MARKFORGED_*.");
       static_assert(SHAPING_ZETA_X == SHAPING_ZETA_Y, "SHAPING_ZETA_X and SHAPING_ZETA_Y must be the same for COREXY / COREYX / MARKFORGED_*.");
+      static_assert(SHAPING_TYPE_X == SHAPING_TYPE_Y, "SHAPING_TYPE_X and SHAPING_TYPE_Y must be the same for COREXY / COREYX / MARKFORGED_*.");
+    #endif
+  #endif
+
+  #if ENABLED(SHAPING_TRAPEZOID)
+    #if ENABLED(S_CURVE_ACCELERATION)
+      #error "SHAPING_TRAPEZOID is not compatible with S_CURVE_ACCELERATION."
+    #elif ENABLED(LIN_ADVANCE)
+      #error "SHAPING_TRAPEZOID is not compatible with LIN_ADVANCE."
+    #elif ENABLED(LASER_POWER_TRAP)
+      #error "SHAPING_TRAPEZOID is not compatible with LASER_POWER_TRAP."
+    #elif ENABLED(__AVR__)
+      #error "SHAPING_TRAPEZOID requires a 32-bit board."
+    #endif
+  #endif
+
+  #if ENABLED(SHAPING_MULTI_IMPULSE)
+    static_assert(WITHIN(SHAPING_TYPE_X, 0, 4), "SHAPING_TYPE_X must be 0 (ZV), 1 (ZVD), 2 (MZV), 3 (EI), or 4 (2HUMP_EI).");
+    static_assert(WITHIN(SHAPING_TYPE_Y, 0, 4), "SHAPING_TYPE_Y must be 0 (ZV), 1 (ZVD), 2 (MZV), 3 (EI), or 4 (2HUMP_EI).");
+  #else
+    static_assert(SHAPING_TYPE_X == 0 && SHAPING_TYPE_Y == 0, "SHAPING_TYPE_[XY] other than 0 (ZV) requires SHAPING_MULTI_IMPULSE.");
+  #endif
+
+  #if ENABLED(SHAPING_AUTOTUNE)
+    #if ENABLED(__AVR__)
+      #error "SHAPING_AUTOTUNE requires a 32-bit board."
+    #elif ENABLED(SHAPING_ACCEL_ADXL345) == ENABLED(SHAPING_ACCEL_SIMULATED)
+      #error "SHAPING_AUTOTUNE requires one of SHAPING_ACCEL_ADXL345 or SHAPING_ACCEL_SIMULATED."
     #endif
+    static_assert(SHAPING_AUTOTUNE_FFT_SIZE == 64 || SHAPING_AUTOTUNE_FFT_SIZE == 128 || SHAPING_AUTOTUNE_FFT_SIZE == 256 || SHAPING_AUTOTUNE_FFT_SIZE == 512, "SHAPING_AUTOTUNE_FFT_SIZE must be 64, 128, 256, or 512.");
+    static_assert(0 < (SHAPING_AUTOTUNE_FREQ_MIN) && (SHAPING_AUTOTUNE_FREQ_MIN) < (SHAPING_AUTOTUNE_FREQ_MAX), "SHAPING_AUTOTUNE_FREQ_MIN must be > 0 and below SHAPING_AUTOTUNE_FREQ_MAX.");
+    static_assert((SHAPING_AUTOTUNE_FREQ_MAX) < 200, "SHAPING_AUTOTUNE_FREQ_MAX must be below half the accelerometer rate (200Hz).");
+    static_assert((SHAPING_AUTOTUNE_HZ_PER_SEC) > 0 && (SHAPING_AUTOTUNE_ACCEL_PER_HZ) > 0, "SHAPING_AUTOTUNE_HZ_PER_SEC and SHAPING_AUTOTUNE_ACCEL_PER_HZ must be > 0.");
   #endif
 
   #ifdef SHAPING_MIN_FREQ
@@ -3895,6 +4127,10 @@ static_assert(_PLUS_TEST(3), "DEFAULT_MAX_ACCELERATION values must be positive."
         static_assert((SHAPING_FREQ_Y) == 0 || (SHAPING_FREQ_Y) * 2 * 0x10000 >= (STEPPER_TIMER_RATE), "SHAPING_FREQ_Y is below the minimum (16) for AVR 16MHz.");
       #endif
     #endif
+    #if ENABLED(SHAPING_MULTI_IMPULSE)
+      TERN_(INPUT_SHAPING_X, static_assert((SHAPING_FREQ_X) == 0 || (SHAPING_FREQ_X) * 2 * 0x10000 >= (STEPPER_TIMER_RATE) * 3, "SHAPING_FREQ_X must be 3x the AVR minimum with SHAPING_MULTI_IMPULSE."));
+      TERN_(INPUT_SHAPING_Y, static_assert((SHAPING_FREQ_Y) == 0 || (SHAPING_FREQ_Y) * 2 * 0x10000 >= (STEPPER_TIMER_RATE) * 3, "SHAPING_FREQ_Y must be 3x the AVR minimum with SHAPING_MULTI_IMPULSE."));
+    #endif
   #endif
 #endif
 
@@ -0,0 +1,63 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2024 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * st7920_diff.h - Send only the changed parts of the ST7920 graphics RAM
+ *
+ * A copy of the display RAM is kept and each row from the u8g page buffer
+ * is compared with it. Unchanged rows are skipped and changed rows are sent
+ * from the first to the last changed 16-bit word. Each frame one row is sent
+ * in full so a glitch from a noisy cable doesn't stay on the screen.
+ */
+
+#include "../../inc/MarlinConfig.h"
+
+class ST7920Diff {
+  static uint8_t shadow[LCD_PIXEL_HEIGHT][(LCD_PIXEL_WIDTH) / 8];
+  static uint8_t refresh_row;
+
+  public:
+    // The display RAM was cleared
+    static void clear() { ZERO(shadow); }
+
+    // Call with the first page of each frame
+    static void next_frame() { if (++refresh_row >= LCD_PIXEL_HEIGHT) refresh_row = 0; }
+
+    /**
+     * Compare a row with what the display already shows and record it as sent.
+     * Return false if nothing changed. Otherwise set the first changed byte and
+     * the number of bytes to send, in whole 16-bit words.
+     */
+    static bool changed(const uint8_t y, const uint8_t * const row, uint8_t &first, uint8_t &count) {
+      uint8_t * const s = shadow[y];
+      int8_t lo = -1, hi = -1;
+      for (uint8_t i = 0; i < (LCD_PIXEL_WIDTH) / 8; ++i)
+        if (row[i] != s[i] || y == refresh_row) { if (lo < 0) lo = i; hi = i; }
+      if (lo < 0) return false;
+      lo &= ~1; hi |= 1;
+      first = lo;
+      count = hi - lo + 1;
+      memcpy(s + first, row + first, count);
+      return true;
+    }
+};
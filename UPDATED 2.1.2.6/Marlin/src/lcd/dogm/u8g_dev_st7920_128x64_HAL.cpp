@@ -59,6 +59,10 @@
 
 #include "HAL_LCD_com_defines.h"
 
+#if ENABLED(ST7920_DIFF_REFRESH)
+  #include "st7920_diff.h"
+#endif
+
 #define PAGE_HEIGHT        8
 
 /* init sequence from https://github.com/adafruit/ST7565-LCD/blob/master/ST7565/ST7565.cpp */
@@ -101,45 +105,57 @@ void clear_graphics_DRAM(u8g_t *u8g, u8g_dev_t *dev) {
   u8g_SetChipSelect(u8g, dev, 0);
 }
 
+// Send the rows of the page buffer to the display
+static void send_page(u8g_t *u8g, u8g_dev_t *dev, const uint8_t rows) {
+  u8g_pb_t *pb = (u8g_pb_t *)(dev->dev_mem);
+  uint8_t y = pb->p.page_y0;
+  uint8_t *ptr = (uint8_t *)pb->buf;
+
+  #if ENABLED(ST7920_DIFF_REFRESH)
+    if (y == 0) ST7920Diff::next_frame();
+  #endif
+
+  u8g_SetAddress(u8g, dev, 0);           /* cmd mode */
+  u8g_SetChipSelect(u8g, dev, 1);
+  for (uint8_t i = 0; i < rows; i++, y++, ptr += (LCD_PIXEL_WIDTH) / 8) {
+    #if ENABLED(ST7920_DIFF_REFRESH)
+      uint8_t first, count;
+      if (!ST7920Diff::changed(y, ptr, first, count)) continue;
+    #else
+      constexpr uint8_t first = 0, count = (LCD_PIXEL_WIDTH) / 8;
+    #endif
+
+    u8g_SetAddress(u8g, dev, 0);           /* cmd mode */
+    u8g_WriteByte(u8g, dev, 0x03E );      /* enable extended mode */
+
+    if (y < 32) {
+      u8g_WriteByte(u8g, dev, 0x080 | y );      /* y pos  */
+      u8g_WriteByte(u8g, dev, 0x080 | (first / 2));      /* x pos in words from 0 */
+    }
+    else {
+      u8g_WriteByte(u8g, dev, 0x080 | (y-32) );      /* y pos  */
+      u8g_WriteByte(u8g, dev, 0x080 | (8 + first / 2));      /* x pos in words from 64 */
+    }
+
+    u8g_SetAddress(u8g, dev, 1);                  /* data mode */
+    u8g_WriteSequence(u8g, dev, count, ptr + first);
+  }
+  u8g_SetChipSelect(u8g, dev, 0);
+}
+
 uint8_t u8g_dev_st7920_128x64_HAL_fn(u8g_t *u8g, u8g_dev_t *dev, uint8_t msg, void *arg) {
   switch (msg) {
     case U8G_DEV_MSG_INIT:
       u8g_InitCom(u8g, dev, U8G_SPI_CLK_CYCLE_400NS);
       u8g_WriteEscSeqP(u8g, dev, u8g_dev_st7920_128x64_HAL_init_seq);
       clear_graphics_DRAM(u8g, dev);
+      TERN_(ST7920_DIFF_REFRESH, ST7920Diff::clear());
       break;
     case U8G_DEV_MSG_STOP:
       break;
-    case U8G_DEV_MSG_PAGE_NEXT: {
-      uint8_t y, i;
-      uint8_t *ptr;
-      u8g_pb_t *pb = (u8g_pb_t *)(dev->dev_mem);
-
-      u8g_SetAddress(u8g, dev, 0);           /* cmd mode */
-      u8g_SetChipSelect(u8g, dev, 1);
-      y = pb->p.page_y0;
-      ptr = (uint8_t *)pb->buf;
-      for (i = 0; i < 8; i ++) {
-        u8g_SetAddress(u8g, dev, 0);           /* cmd mode */
-        u8g_WriteByte(u8g, dev, 0x03E );      /* enable extended mode */
-
-        if (y < 32) {
-          u8g_WriteByte(u8g, dev, 0x080 | y );      /* y pos  */
-          u8g_WriteByte(u8g, dev, 0x080  );      /* set x pos to 0*/
-        }
-        else {
-          u8g_WriteByte(u8g, dev, 0x080 | (y-32) );      /* y pos  */
-          u8g_WriteByte(u8g, dev, 0x080 | 8);      /* set x pos to 64*/
-        }
-
-        u8g_SetAddress(u8g, dev, 1);                  /* data mode */
-        u8g_WriteSequence(u8g, dev, (LCD_PIXEL_WIDTH) / 8, ptr);
-        ptr += (LCD_PIXEL_WIDTH) / 8;
-        y++;
-      }
-      u8g_SetChipSelect(u8g, dev, 0);
-    }
-    break;
+    case U8G_DEV_MSG_PAGE_NEXT:
+      send_page(u8g, dev, 8);
+      break;
   }
   return u8g_dev_pb8h1_base_fn(u8g, dev, msg, arg);
 }
@@ -150,41 +166,15 @@ uint8_t u8g_dev_st7920_128x64_HAL_4x_fn(u8g_t *u8g, u8g_dev_t *dev, uint8_t msg,
       u8g_InitCom(u8g, dev, U8G_SPI_CLK_CYCLE_400NS);
       u8g_WriteEscSeqP(u8g, dev, u8g_dev_st7920_128x64_HAL_init_seq);
       clear_graphics_DRAM(u8g, dev);
+      TERN_(ST7920_DIFF_REFRESH, ST7920Diff::clear());
       break;
 
     case U8G_DEV_MSG_STOP:
       break;
 
-    case U8G_DEV_MSG_PAGE_NEXT: {
-      uint8_t y, i;
-      uint8_t *ptr;
-      u8g_pb_t *pb = (u8g_pb_t *)(dev->dev_mem);
-
-      u8g_SetAddress(u8g, dev, 0);           /* cmd mode */
-      u8g_SetChipSelect(u8g, dev, 1);
-      y = pb->p.page_y0;
-      ptr = (uint8_t *)pb->buf;
-      for (i = 0; i < 32; i ++) {
-        u8g_SetAddress(u8g, dev, 0);           /* cmd mode */
-        u8g_WriteByte(u8g, dev, 0x03E );      /* enable extended mode */
-
-        if (y < 32) {
-          u8g_WriteByte(u8g, dev, 0x080 | y );      /* y pos  */
-          u8g_WriteByte(u8g, dev, 0x080  );      /* set x pos to 0*/
-        }
-        else {
-          u8g_WriteByte(u8g, dev, 0x080 | (y-32) );      /* y pos  */
-          u8g_WriteByte(u8g, dev, 0x080 | 8);      /* set x pos to 64*/
-        }
-
-        u8g_SetAddress(u8g, dev, 1);                  /* data mode */
-        u8g_WriteSequence(u8g, dev, (LCD_PIXEL_WIDTH) / 8, ptr);
-        ptr += (LCD_PIXEL_WIDTH) / 8;
-        y++;
-      }
-      u8g_SetChipSelect(u8g, dev, 0);
-    }
-    break;
+    case U8G_DEV_MSG_PAGE_NEXT:
+      send_page(u8g, dev, 32);
+      break;
   }
   return u8g_dev_pb32h1_base_fn(u8g, dev, msg, arg);
 }
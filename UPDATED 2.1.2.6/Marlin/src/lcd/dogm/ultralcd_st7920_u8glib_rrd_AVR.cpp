@@ -33,6 +33,10 @@
 
 #include "ultralcd_st7920_u8glib_rrd_AVR.h"
 
+#if ENABLED(ST7920_DIFF_REFRESH)
+  #include "st7920_diff.h"
+#endif
+
 // Optimize this code with -O3
 #pragma GCC optimize (3)
 
@@ -138,6 +142,7 @@ uint8_t u8g_dev_rrd_st7920_128x64_fn(u8g_t *u8g, u8g_dev_t *dev, uint8_t msg, vo
       }
       ST7920_WRITE_BYTE(0x0C);        // Display on, cursor+blink off
       ST7920_NCS();
+      TERN_(ST7920_DIFF_REFRESH, ST7920Diff::clear());
     }
     break;
 
@@ -149,19 +154,32 @@ uint8_t u8g_dev_rrd_st7920_128x64_fn(u8g_t *u8g, u8g_dev_t *dev, uint8_t msg, vo
       y = pb->p.page_y0;
       ptr = (uint8_t*)pb->buf;
 
+      #if ENABLED(ST7920_DIFF_REFRESH)
+        if (y == 0) ST7920Diff::next_frame();
+      #endif
+
       ST7920_CS();
       for (i = 0; i < PAGE_HEIGHT; i ++) {
+        #if ENABLED(ST7920_DIFF_REFRESH)
+          uint8_t first, count;
+          if (!ST7920Diff::changed(y, ptr, first, count)) { ptr += (LCD_PIXEL_WIDTH) / 8; y++; continue; }
+          uint8_t *p = ptr + first;
+          ptr += (LCD_PIXEL_WIDTH) / 8;
+        #else
+          constexpr uint8_t first = 0, count = (LCD_PIXEL_WIDTH) / 8;
+          uint8_t * &p = ptr;
+        #endif
         ST7920_SET_CMD();
         if (y < 32) {
-          ST7920_WRITE_BYTE(0x80 | y);        // y
-          ST7920_WRITE_BYTE(0x80);            // x = 0
+          ST7920_WRITE_BYTE(0x80 | y);                // y
+          ST7920_WRITE_BYTE(0x80 | (first / 2));      // x = 0 + words
         }
         else {
-          ST7920_WRITE_BYTE(0x80 | (y - 32)); // y
-          ST7920_WRITE_BYTE(0x80 | 8);        // x = 64
+          ST7920_WRITE_BYTE(0x80 | (y - 32));         // y
+          ST7920_WRITE_BYTE(0x80 | (8 + first / 2));  // x = 64 + words
         }
         ST7920_SET_DAT();
-        ST7920_WRITE_BYTES(ptr, (LCD_PIXEL_WIDTH) / 8); // ptr incremented inside of macro!
+        ST7920_WRITE_BYTES(p, count); // p incremented inside of macro!
         y++;
       }
       ST7920_NCS();
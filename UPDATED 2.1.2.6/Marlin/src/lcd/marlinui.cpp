@@ -36,6 +36,10 @@
   #include "../feature/password/password.h"
 #endif
 
+#if ENABLED(CPU_PROFILER)
+  #include "../feature/cpu_profiler.h"
+#endif
+
 // All displays share the MarlinUI class
 #include "marlinui.h"
 MarlinUI ui;
@@ -925,6 +929,7 @@ void MarlinUI::init() {
   }
 
   void MarlinUI::update() {
+    TERN_(CPU_PROFILER, PROFILE_SCOPE(UI_UPDATE));
 
     static uint16_t max_display_update_time = 0;
     millis_t ms = millis();
@@ -1144,23 +1149,38 @@ void MarlinUI::init() {
           #endif
 
           if (do_u8g_loop) {
-            if (!drawing_screen) {                // If not already drawing pages
-              u8g.firstPage();                    // Start the first page
-              drawing_screen = first_page = true; // Flag as drawing pages
-            }
-            set_font(FONT_MENU);                  // Setup font for every page draw
-            u8g.setColorIndex(1);                 // And reset the color
-            run_current_screen();                 // Draw and process the current screen
-            first_page = false;
+            #if ENABLED(CPU_PROFILER)
+              static uint32_t frame_cycles = 0;
+            #endif
+            do {
+              TERN_(CPU_PROFILER, const ProfileTally page_tally(frame_cycles));
+              if (!drawing_screen) {                // If not already drawing pages
+                u8g.firstPage();                    // Start the first page
+                drawing_screen = first_page = true; // Flag as drawing pages
+              }
+              set_font(FONT_MENU);                  // Setup font for every page draw
+              u8g.setColorIndex(1);                 // And reset the color
+              run_current_screen();                 // Draw and process the current screen
+              first_page = false;
 
-            // The screen handler can clear drawing_screen for an action that changes the screen.
-            // If still drawing and there's another page, update max-time and return now.
+              // The screen handler can clear drawing_screen for an action that changes the screen.
+              if (drawing_screen) drawing_screen = u8g.nextPage();
+
+              // With time left in the budget draw the next page now
+            } while (drawing_screen && TERN0(ST7920_DIFF_REFRESH, PENDING(millis(), ms + (ST7920_DIFF_BUDGET_MS))));
+
+            // If still drawing there's another page. Update max-time and return now.
             // The nextPage will already be set up on the next call.
-            if (drawing_screen && (drawing_screen = u8g.nextPage())) {
+            if (drawing_screen) {
               if (on_status_screen())
                 NOLESS(max_display_update_time, millis() - ms);
               return;
             }
+
+            #if ENABLED(CPU_PROFILER)
+              CPUProfiler::add(PROFILE_UI_FRAME, frame_cycles, 0);
+              frame_cycles = 0;
+            #endif
           }
 
         #else
@@ -1734,6 +1754,9 @@ void MarlinUI::init() {
   MarlinUI::progress_t MarlinUI::_get_progress() {
     return (
       TERN0(SET_PROGRESS_PERCENT, (progress_override & PROGRESS_MASK))
+      #if ENABLED(SD_JOB_ESTIMATE)
+        ?: progress_t(job_estimate.permyriad() / (100U / (PROGRESS_SCALE)))
+      #endif
       #if HAS_MEDIA
         ?: TERN(HAS_PRINT_PROGRESS_PERMYRIAD, card.permyriadDone(), card.percentDone())
       #endif
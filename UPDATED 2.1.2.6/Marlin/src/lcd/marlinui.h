@@ -43,6 +43,10 @@
   #include "../module/printcounter.h"
 #endif
 
+#if ENABLED(SD_JOB_ESTIMATE)
+  #include "../feature/job_estimate.h"
+#endif
+
 #if ENABLED(ADVANCED_PAUSE_FEATURE)
   #include "../feature/pause.h"
 #endif
@@ -316,6 +320,9 @@ public:
     #endif
     #if ANY(SHOW_REMAINING_TIME, SET_PROGRESS_MANUALLY)
       static uint32_t _calculated_remaining_time() {
+        #if ENABLED(SD_JOB_ESTIMATE)
+          if (const uint32_t r = job_estimate.remaining()) return r;
+        #endif
         const duration_t elapsed = print_job_timer.duration();
         const progress_t progress = _get_progress();
         return progress ? elapsed.value * (100 * (PROGRESS_SCALE) - progress) / progress : 0;
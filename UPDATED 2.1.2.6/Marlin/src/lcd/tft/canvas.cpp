@@ -41,11 +41,15 @@ void CANVAS::New(uint16_t x, uint16_t y, uint16_t width, uint16_t height) {
 
 void CANVAS::Continue() {
   startLine = endLine;
-  endLine = TFT_BUFFER_WORDS < width * (height - startLine) ? startLine + TFT_BUFFER_WORDS / width : height;
+  endLine = CANVAS_BUFFER_WORDS < width * (height - startLine) ? startLine + CANVAS_BUFFER_WORDS / width : height;
 }
 
 bool CANVAS::ToScreen() {
   tft.write_sequence(buffer, width * (endLine - startLine));
+  #if ENABLED(TFT_DOUBLE_BUFFER)
+    // Draw the next tile into the other half while this one is sent
+    buffer = buffer == TFT::buffer ? TFT::buffer + CANVAS_BUFFER_WORDS : TFT::buffer;
+  #endif
   return endLine == height;
 }
 
@@ -70,6 +70,17 @@
   #error "TFT_BUFFER_WORDS can not exceed DMA_MAX_WORDS"
 #endif
 
+#if ENABLED(TFT_DOUBLE_BUFFER)
+  // Canvas tiles use one half of the buffer each
+  #define CANVAS_BUFFER_WORDS (TFT_BUFFER_WORDS / 2)
+#else
+  #define CANVAS_BUFFER_WORDS TFT_BUFFER_WORDS
+#endif
+
+#if CANVAS_BUFFER_WORDS < TFT_WIDTH
+  #error "TFT_BUFFER_WORDS is too small to hold one line of each canvas tile."
+#endif
+
 class TFT {
   private:
     static TFT_String string;
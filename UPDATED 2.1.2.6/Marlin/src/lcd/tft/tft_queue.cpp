@@ -102,13 +102,28 @@ void TFT_Queue::fill(queueTask_t *task) {
 void TFT_Queue::canvas(queueTask_t *task) {
   parametersCanvas_t *task_parameters = (parametersCanvas_t *)(((uint8_t *)task) + sizeof(queueTask_t));
 
-  uint16_t i;
-  uint8_t *item = ((uint8_t *)task_parameters) + sizeof(parametersCanvas_t);
-
   if (task->state == TASK_STATE_READY) {
     task->state = TASK_STATE_IN_PROGRESS;
     Canvas.New(task_parameters->x, task_parameters->y, task_parameters->width, task_parameters->height);
+    TERN_(TFT_DOUBLE_BUFFER, render_tile(task_parameters));
   }
+
+  #if ENABLED(TFT_DOUBLE_BUFFER)
+    // Send the tile rendered last time and draw the next one while DMA runs
+    if (Canvas.ToScreen())
+      task->state = TASK_STATE_COMPLETED;
+    else
+      render_tile(task_parameters);
+  #else
+    render_tile(task_parameters);
+    if (Canvas.ToScreen()) task->state = TASK_STATE_COMPLETED;
+  #endif
+}
+
+void TFT_Queue::render_tile(parametersCanvas_t *task_parameters) {
+  uint16_t i;
+  uint8_t *item = ((uint8_t *)task_parameters) + sizeof(parametersCanvas_t);
+
   Canvas.Continue();
 
   for (i = 0; i < task_parameters->count; i++) {
@@ -138,8 +153,6 @@ void TFT_Queue::canvas(queueTask_t *task) {
     }
     item = ((parametersCanvasBackground_t *)item)->nextParameter;
   }
-
-  if (Canvas.ToScreen()) task->state = TASK_STATE_COMPLETED;
 }
 
 void TFT_Queue::fill(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t color) {
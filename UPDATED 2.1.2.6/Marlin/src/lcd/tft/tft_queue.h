@@ -129,6 +129,7 @@ class TFT_Queue {
     static void finish_sketch();
     static void fill(queueTask_t *task);
     static void canvas(queueTask_t *task);
+    static void render_tile(parametersCanvas_t *task_parameters);
     static void handle_queue_overflow(uint16_t sizeNeeded);
 
   public:
@@ -0,0 +1,94 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2024 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * fft.h - Fixed-point radix-2 FFT
+ *
+ * In-place transform of 16-bit data with a quarter-wave Q15 sine table.
+ * Every stage halves its outputs, so the result is the DFT divided by the
+ * size and can't overflow as long as the input magnitudes are below 2^14.
+ */
+
+#include "../inc/MarlinConfig.h"
+#include <math.h>
+
+template<uint8_t LOG2N>
+class FixedFFT {
+  public:
+    static constexpr uint16_t size = 1U << LOG2N;
+
+    // Fill the sine table. Call once before use.
+    static void init() {
+      for (uint16_t k = 0; k <= size / 4; ++k)
+        sine[k] = int16_t(LROUND(32767.0f * sinf(float(M_PI) * 2 * k / size)));
+    }
+
+    // sin(2πk/size) and cos(2πk/size) in Q15
+    static int16_t sin_q15(const uint16_t k) {
+      const uint16_t r = k & (size / 4 - 1);
+      switch ((k / (size / 4)) & 3) {
+        default:
+        case 0: return sine[r];
+        case 1: return sine[size / 4 - r];
+        case 2: return -sine[r];
+        case 3: return -sine[size / 4 - r];
+      }
+    }
+    static int16_t cos_q15(const uint16_t k) { return sin_q15(k + size / 4); }
+
+    // Hann window coefficient for sample 'i' in Q15
+    static int16_t hann(const uint16_t i) { return (32767 - cos_q15(i)) >> 1; }
+
+    // Forward transform. Inputs must be within ±16383.
+    static void transform(int16_t re[], int16_t im[]) {
+      // Bit-reversed reordering
+      for (uint16_t i = 1, j = 0; i < size; ++i) {
+        uint16_t bit = size >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j) {
+          int16_t t = re[i]; re[i] = re[j]; re[j] = t;
+          t = im[i]; im[i] = im[j]; im[j] = t;
+        }
+      }
+      // Butterflies with the twiddle e^(-2πjk/len), halving each stage
+      for (uint16_t len = 2, stride = size >> 1; len <= size; len <<= 1, stride >>= 1) {
+        const uint16_t half = len >> 1;
+        for (uint16_t k = 0; k < half; ++k) {
+          const int32_t c = cos_q15(k * stride), s = sin_q15(k * stride);
+          for (uint16_t i = k; i < size; i += len) {
+            const uint16_t j = i + half;
+            const int32_t tr = (re[j] * c + im[j] * s) >> 15,
+                          ti = (im[j] * c - re[j] * s) >> 15;
+            re[j] = (re[i] - tr) >> 1; im[j] = (im[i] - ti) >> 1;
+            re[i] = (re[i] + tr) >> 1; im[i] = (im[i] + ti) >> 1;
+          }
+        }
+      }
+    }
+
+  private:
+    static int16_t sine[size / 4 + 1];
+};
+
+template<uint8_t LOG2N> int16_t FixedFFT<LOG2N>::sine[FixedFFT<LOG2N>::size / 4 + 1];
@@ -66,4 +66,220 @@ int finish_incremental_LSF(struct linear_fit_data *lsf) {
   return 0;
 }
 
+#if ENABLED(LSF_ROBUST_FIT)
+
+  // Small xorshift generator with a fixed seed so fits are repeatable
+  static uint32_t lsf_seed;
+  static uint16_t lsf_random(const uint16_t n) {
+    lsf_seed ^= lsf_seed << 13;
+    lsf_seed ^= lsf_seed >> 17;
+    lsf_seed ^= lsf_seed << 5;
+    return lsf_seed % n;
+  }
+
+  int finish_robust_LSF(struct linear_fit_data *lsf, const float x[], const float y[], const float z[], const uint16_t n,
+                        const_float_t threshold, struct lsf_residuals *res
+  ) {
+    if (res) *res = {};
+
+    // Trial plane z = ta * x + tb * y + tc. Used to classify inliers.
+    float ta = 0, tb = 0, tc = 0;
+    uint16_t best_count = 0;
+
+    if (n >= 5) {
+      lsf_seed = 0x2545F491UL;
+      for (uint8_t it = 0; it < LSF_RANSAC_ITERATIONS; ++it) {
+        // Pick three distinct points
+        const uint16_t i = lsf_random(n);
+        uint16_t j = lsf_random(n - 1), k = lsf_random(n - 2);
+        if (j >= i) ++j;
+        if (k >= _MIN(i, j)) ++k;
+        if (k >= _MAX(i, j)) ++k;
+
+        // Plane normal from the cross product of two edges
+        const float ux = x[j] - x[i], uy = y[j] - y[i], uz = z[j] - z[i],
+                    vx = x[k] - x[i], vy = y[k] - y[i], vz = z[k] - z[i],
+                    nz = ux * vy - uy * vx;
+        if (ABS(nz) < 1e-3f) continue;  // Collinear in XY
+
+        const float a = (uz * vy - uy * vz) / nz,
+                    b = (ux * vz - uz * vx) / nz,
+                    c = z[i] - a * x[i] - b * y[i];
+
+        uint16_t count = 0;
+        for (uint16_t p = 0; p < n; ++p)
+          if (ABS(z[p] - (a * x[p] + b * y[p] + c)) <= threshold) ++count;
+
+        if (count > best_count) {
+          best_count = count;
+          ta = a; tb = b; tc = c;
+          if (count == n) break;
+        }
+      }
+    }
+
+    // Too few points or no consensus? Use them all.
+    const bool use_all = best_count < 3 || best_count == n;
+    auto is_inlier = [&](const uint16_t p) {
+      return use_all || ABS(z[p] - (ta * x[p] + tb * y[p] + tc)) <= threshold;
+    };
+
+    incremental_LSF_reset(lsf);
+    uint16_t inliers = 0;
+    for (uint16_t p = 0; p < n; ++p)
+      if (is_inlier(p)) { incremental_LSF(lsf, x[p], y[p], z[p]); ++inliers; }
+
+    // Keep the trial plane so the rejected points can be listed
+    if (res) {
+      res->inliers = inliers;
+      res->outliers = n - inliers;
+      if (!use_all) { res->trial[0] = ta; res->trial[1] = tb; res->trial[2] = tc; }
+    }
+
+    if (finish_incremental_LSF(lsf)) return 1;
+
+    if (res) {
+      float max = 0, sum2 = 0;
+      for (uint16_t p = 0; p < n; ++p) {
+        if (!is_inlier(p)) continue;
+        const float r = incremental_LSF_residual(lsf, x[p], y[p], z[p]);
+        NOLESS(max, ABS(r));
+        sum2 += sq(r);
+      }
+      res->max = max;
+      res->rms = SQRT(sum2 / inliers);
+    }
+
+    return 0;
+  }
+
+  void report_LSF_residuals(const struct lsf_residuals &res) {
+    SERIAL_ECHOPAIR_F("Fit residual max: ", res.max, 4);
+    SERIAL_ECHOPAIR_F(" rms: ", res.rms, 4);
+    SERIAL_ECHOLNPGM(" points: ", res.inliers, " rejected: ", res.outliers);
+  }
+
+  #if ENABLED(LSF_QUADRATIC_REPORT)
+
+    int quadratic_LSF(struct quadratic_fit_data *qsf, const float x[], const float y[], const float z[], const uint16_t n, struct lsf_residuals *res) {
+      if (n < 6) return 1;
+
+      // Center and scale X and Y to [-1, 1] to keep the normal equations well-conditioned
+      float cx = 0, cy = 0;
+      for (uint16_t p = 0; p < n; ++p) { cx += x[p]; cy += y[p]; }
+      cx /= n; cy /= n;
+      float rx = 0, ry = 0;
+      for (uint16_t p = 0; p < n; ++p) { NOLESS(rx, ABS(x[p] - cx)); NOLESS(ry, ABS(y[p] - cy)); }
+      if (rx == 0 || ry == 0) return 1;
+      qsf->cx = cx; qsf->cy = cy;
+      qsf->sx = 1.0f / rx; qsf->sy = 1.0f / ry;
+
+      // Accumulate the normal equations as an augmented matrix
+      float m[6][7] = { { 0 } };
+      for (uint16_t p = 0; p < n; ++p) {
+        const float u = (x[p] - cx) * qsf->sx, v = (y[p] - cy) * qsf->sy,
+                    t[6] = { 1, u, v, sq(u), u * v, sq(v) };
+        for (uint8_t r = 0; r < 6; ++r) {
+          for (uint8_t c = 0; c < 6; ++c) m[r][c] += t[r] * t[c];
+          m[r][6] += t[r] * z[p];
+        }
+      }
+
+      // Gaussian elimination with partial pivoting
+      for (uint8_t c = 0; c < 6; ++c) {
+        uint8_t piv = c;
+        for (uint8_t r = c + 1; r < 6; ++r) if (ABS(m[r][c]) > ABS(m[piv][c])) piv = r;
+        if (ABS(m[piv][c]) < 1e-6f) return 1;
+        if (piv != c) for (uint8_t k = c; k < 7; ++k) { const float t = m[c][k]; m[c][k] = m[piv][k]; m[piv][k] = t; }
+        for (uint8_t r = c + 1; r < 6; ++r) {
+          const float f = m[r][c] / m[c][c];
+          for (uint8_t k = c; k < 7; ++k) m[r][k] -= f * m[c][k];
+        }
+      }
+      for (int8_t r = 5; r >= 0; --r) {
+        float v = m[r][6];
+        for (uint8_t k = r + 1; k < 6; ++k) v -= m[r][k] * qsf->c[k];
+        qsf->c[r] = v / m[r][r];
+      }
+
+      if (res) {
+        float max = 0, sum2 = 0;
+        for (uint16_t p = 0; p < n; ++p) {
+          const float r = z[p] - quadratic_LSF_eval(qsf, x[p], y[p]);
+          NOLESS(max, ABS(r));
+          sum2 += sq(r);
+        }
+        res->max = max;
+        res->rms = SQRT(sum2 / n);
+        res->inliers = n;
+        res->outliers = 0;
+      }
+
+      return 0;
+    }
+
+  #endif // LSF_QUADRATIC_REPORT
+
+  #if ENABLED(MARLIN_TEST_BUILD)
+
+    /**
+     * Fit known planes on a 5x5 grid, with and without spikes, and check
+     * the plane found and the points rejected.
+     */
+    void test_robust_LSF() {
+      constexpr uint16_t n = 25;
+      float x[n], y[n], z[n];
+      const float a = 0.01f, b = -0.02f, c = 0.3f;    // z = a * x + b * y + c
+      for (uint16_t p = 0; p < n; ++p) {
+        x[p] = 10 + 45 * (p % 5);
+        y[p] = 10 + 45 * (p / 5);
+        z[p] = a * x[p] + b * y[p] + c;
+      }
+
+      linear_fit_data lsf;
+      lsf_residuals res;
+      auto plane_ok = [&]{ return ABS(lsf.A + a) < 1e-4f && ABS(lsf.B + b) < 1e-4f && ABS(lsf.D + c) < 1e-3f; };
+      auto report = [](FSTR_P const name, const bool pass) {
+        SERIAL_ECHOPGM("LSF robust fit test ");
+        SERIAL_ECHOF(name);
+        SERIAL_ECHOLNF(pass ? F(": PASS") : F(": FAIL"));
+      };
+
+      // A flat plane has nothing to reject
+      bool pass = !finish_robust_LSF(&lsf, x, y, z, n, LSF_OUTLIER_THRESHOLD, &res)
+               && plane_ok() && res.outliers == 0 && res.max < 1e-3f;
+      report(F("plane"), pass);
+
+      // Two spikes are rejected and don't tilt the plane
+      const uint16_t spike1 = 7, spike2 = 18;
+      z[spike1] += 0.5f;
+      z[spike2] -= 0.4f;
+      pass = !finish_robust_LSF(&lsf, x, y, z, n, LSF_OUTLIER_THRESHOLD, &res)
+          && plane_ok() && res.outliers == 2 && res.inliers == n - 2 && res.max < 1e-3f;
+      // The points listed as rejected are the spikes, judged by the trial plane
+      for (uint16_t p = 0; p < n; ++p)
+        if (LSF_rejected(res, x[p], y[p], z[p]) != (p == spike1 || p == spike2)) pass = false;
+      report(F("spikes"), pass);
+
+      // With fewer than 5 points all are used
+      const uint16_t o = spike1 - 3;                  // Points 4-7, with the spike
+      pass = !finish_robust_LSF(&lsf, x + o, y + o, z + o, 4, LSF_OUTLIER_THRESHOLD, &res)
+          && res.outliers == 0 && res.inliers == 4 && !LSF_rejected(res, x[spike1], y[spike1], z[spike1]);
+      report(F("few points"), pass);
+
+      #if ENABLED(LSF_QUADRATIC_REPORT)
+        // A bow along X shows up in the X squared term
+        z[spike1] -= 0.5f;
+        z[spike2] += 0.4f;
+        for (uint16_t p = 0; p < n; ++p) z[p] += 0.2f * sq((x[p] - 100) / 90);
+        quadratic_fit_data qsf;
+        pass = !quadratic_LSF(&qsf, x, y, z, n, &res) && ABS(qsf.c[3] - 0.2f) < 1e-3f && ABS(qsf.c[5]) < 1e-3f && res.max < 1e-3f;
+        report(F("quadratic"), pass);
+      #endif
+    }
+
+  #endif // MARLIN_TEST_BUILD
+
+#endif // LSF_ROBUST_FIT
+
 #endif // NEED_LSF
@@ -85,3 +85,63 @@ inline void incremental_LSF(struct linear_fit_data *lsf, const xy_pos_t &pos, co
 }
 
 int finish_incremental_LSF(struct linear_fit_data *);
+
+// Distance along Z from the fitted plane (z = -(Ax + By + D)) to the given point
+inline float incremental_LSF_residual(const struct linear_fit_data *lsf, const_float_t x, const_float_t y, const_float_t z) {
+  return z + lsf->A * x + lsf->B * y + lsf->D;
+}
+
+#if ENABLED(LSF_ROBUST_FIT)
+
+  /**
+   * Robust plane fit with outlier rejection
+   *
+   * All probed points must be kept in memory. With 5 or more points a RANSAC
+   * pass picks the 3-point trial plane agreeing with the most points, then the
+   * plane is refit using only the points within the threshold of that trial plane.
+   * With fewer points an ordinary least-squares fit is done.
+   */
+  struct lsf_residuals {
+    float max,            // Largest absolute residual among the inliers
+          rms;            // Root-mean-square residual of the inliers
+    uint16_t inliers,     // Points used for the final fit
+             outliers;    // Points rejected as spikes
+    float trial[3];       // Trial plane z = trial[0] * x + trial[1] * y + trial[2] that picked the inliers
+  };
+
+  int finish_robust_LSF(struct linear_fit_data *lsf, const float x[], const float y[], const float z[], const uint16_t n,
+                        const_float_t threshold=LSF_OUTLIER_THRESHOLD, struct lsf_residuals *res=nullptr);
+
+  // Whether a point was rejected by the trial plane of a robust fit
+  inline bool LSF_rejected(const struct lsf_residuals &res, const_float_t x, const_float_t y, const_float_t z, const_float_t threshold=LSF_OUTLIER_THRESHOLD) {
+    return res.outliers && ABS(z - (res.trial[0] * x + res.trial[1] * y + res.trial[2])) > threshold;
+  }
+
+  void report_LSF_residuals(const struct lsf_residuals &res);
+
+  #if ENABLED(LSF_QUADRATIC_REPORT)
+
+    /**
+     * Quadratic surface fit z = c0 + c1*u + c2*v + c3*u^2 + c4*u*v + c5*v^2
+     * with u, v the X, Y coordinates normalized to the probed area for stability.
+     * Requires at least 6 points that are not all on one line.
+     */
+    struct quadratic_fit_data {
+      float cx, cy, sx, sy,   // Normalization: u = (x - cx) * sx, v = (y - cy) * sy
+            c[6];             // Surface coefficients
+    };
+
+    int quadratic_LSF(struct quadratic_fit_data *qsf, const float x[], const float y[], const float z[], const uint16_t n, struct lsf_residuals *res=nullptr);
+
+    inline float quadratic_LSF_eval(const struct quadratic_fit_data *qsf, const_float_t x, const_float_t y) {
+      const float u = (x - qsf->cx) * qsf->sx, v = (y - qsf->cy) * qsf->sy;
+      return qsf->c[0] + qsf->c[1] * u + qsf->c[2] * v + qsf->c[3] * sq(u) + qsf->c[4] * u * v + qsf->c[5] * sq(v);
+    }
+
+  #endif
+
+  #if ENABLED(MARLIN_TEST_BUILD)
+    void test_robust_LSF();
+  #endif
+
+#endif // LSF_ROBUST_FIT
@@ -0,0 +1,219 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2024 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * ik_extrapolation.cpp - Inverse kinematics by extrapolation
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(IK_EXTRAPOLATION)
+
+#include "ik_extrapolation.h"
+#include "motion.h"
+
+#if ENABLED(DELTA)
+  #include "delta.h"
+#elif IS_SCARA
+  #include "scara.h"
+#elif ENABLED(POLARGRAPH)
+  #include "polargraph.h"
+#endif
+
+IKExtrapolation ik_extrapolation;
+
+float IKExtrapolation::max_error; // = 0
+abc_pos_t IKExtrapolation::q, IKExtrapolation::d1, IKExtrapolation::d2, IKExtrapolation::d3;
+#if ENABLED(DELTA)
+  xy_pos_t IKExtrapolation::prev_xy;
+#else
+  abc_pos_t IKExtrapolation::anchor[4];
+#endif
+uint8_t IKExtrapolation::phase, // = 0
+        IKExtrapolation::span = IK_EXACT_INTERVAL;
+
+#if ENABLED(DELTA)
+
+  /**
+   * Each tower height is Z + S, with S = sqrt(L^2 - |T - P|^2) for tower T and
+   * effector P. Since S^2 + |T - P|^2 is constant, for the segment vector V the
+   * derivatives of S per segment are:
+   *   dS  = ((T - P) . V) / S
+   *   d2S = -(|V|^2 + dS^2) / S
+   *   d3S = -3 * dS * d2S / S
+   *   d4S = -(3 * d2S^2 + 4 * dS * d3S) / S
+   * The cubic is exact up to d4S * k^4 / 24 after k segments, so the cycle is
+   * cut short where the rods are steep. Z is taken as-is from each segment so
+   * leveling corrections are exact.
+   */
+  void IKExtrapolation::solve(const xyz_pos_t &raw, const bool continue_line) {
+    xy_pos_t pos = raw;
+    TERN_(HAS_HOTEND_OFFSET, pos -= hotend_offset[active_extruder]);
+
+    if (continue_line && WITHIN(phase, 1, span - 1)) {
+      q += d1;
+      d1 += d2;
+      d2 += d3;
+      ++phase;
+      delta.set(raw.z + q.a, raw.z + q.b, raw.z + q.c);
+    }
+    else {
+      const abc_pos_t predicted = q + d1;
+      const bool was_extrapolating = continue_line && phase;
+
+      inverse_kinematics(raw);
+
+      if (was_extrapolating)
+        NOLESS(max_error, _MAX(ABS(delta.a - raw.z - predicted.a), ABS(delta.b - raw.z - predicted.b), ABS(delta.c - raw.z - predicted.c)));
+
+      if (continue_line) {
+        const xy_pos_t v = pos - prev_xy;
+        const float v2 = sq(v.x) + sq(v.y);
+        float s4max = 0;
+        LOOP_ABC(t) {
+          const xy_pos_t tp = delta_tower[t] - pos;
+          const float S = delta[t] - raw.z, inv_S = 1.0f / S,
+                      s1 = (tp.x * v.x + tp.y * v.y) * inv_S,
+                      s2 = -(v2 + sq(s1)) * inv_S,
+                      s3 = -3.0f * s1 * s2 * inv_S;
+          // Forward differences of the cubic Taylor polynomial
+          q[t] = S;
+          d1[t] = s1 + s2 * 0.5f + s3 * (1.0f / 6.0f);
+          d2[t] = s2 + s3;
+          d3[t] = s3;
+          NOLESS(s4max, ABS(3.0f * sq(s2) + 4.0f * s1 * s3) * inv_S);
+        }
+        for (span = IK_EXACT_INTERVAL; span > 1 && s4max * sq(sq(float(span))) > 24.0f * (IK_EXTRAPOLATION_TOLERANCE);) span >>= 1;
+        phase = 1;
+      }
+      else
+        phase = 0;
+    }
+
+    prev_xy = pos;
+  }
+
+#else
+
+  /**
+   * Each cycle starts with five full solves in a row. The last four give the
+   * forward differences of the cubic through them. After k more segments the
+   * cubic is off by about D4 * C(k+3, 4), with D4 the fourth difference of all
+   * five, plus the float rounding of the solves times about 8 * C(k+2, 3).
+   * The span is set from those before any point is extrapolated.
+   */
+  void IKExtrapolation::solve(const xyz_pos_t &raw, const bool continue_line) {
+    if (!continue_line) phase = 0;
+
+    if (WITHIN(phase, 5, span - 1)) {
+      q += d1;
+      d1 += d2;
+      d2 += d3;
+      ++phase;
+      delta.set(q.a, q.b, q.c);
+      return;
+    }
+
+    const abc_pos_t predicted = q + d1;
+    const bool was_extrapolating = phase >= 5;
+
+    inverse_kinematics(raw);
+    const abc_pos_t p = { delta.a, delta.b, delta.c };
+
+    if (was_extrapolating) {
+      NOLESS(max_error, _MAX(ABS(p.a - predicted.a), ABS(p.b - predicted.b), ABS(p.c - predicted.c)));
+      phase = 0;
+    }
+
+    if (phase < 4)
+      anchor[phase] = p;
+    else {
+      // Backward differences at p, from the last four solves
+      const abc_pos_t b1 = p - anchor[3],
+                      b2 = b1 - anchor[3] + anchor[2],
+                      b3 = b2 - anchor[3] + anchor[2] * 2.0f - anchor[1],
+                      b4 = b3 - anchor[3] + anchor[2] * 3.0f - anchor[1] * 3.0f + anchor[0];
+      // Forward differences for the segments after p
+      d3 = b3;
+      d2 = b2 + b3 * 2.0f;
+      d1 = b1 + b2 + b3;
+      q = p;
+
+      const float e4 = _MAX(ABS(b4.a), ABS(b4.b), ABS(b4.c)),
+                  e3 = _MAX(ABS(p.a), ABS(p.b), ABS(p.c)) * (8.0f * __FLT_EPSILON__);
+      for (span = IK_EXACT_INTERVAL; span > 5; --span) {
+        const float k = span - 5, c3 = k * (k + 1) * (k + 2) * (1.0f / 6.0f);
+        if (e4 * c3 * (k + 3) * 0.25f + e3 * c3 <= (IK_EXTRAPOLATION_TOLERANCE)) break;
+      }
+    }
+    ++phase;
+  }
+
+#endif
+
+#if ENABLED(MARLIN_TEST_BUILD)
+
+  /**
+   * Step along a few lines through the printable area at the default
+   * segment length and compare every extrapolated point to a full solve.
+   * Every point has to be within the tolerance.
+   */
+  void IKExtrapolation::test() {
+    const abce_pos_t saved_delta = delta;
+    const float seg_mm = 100.0f / segments_per_second; // Segments at 100mm/s
+    // Diagonals and a center line, inset toward the bed center
+    #define _INSET(A,P) (A##_CENTER + ((P) - (A##_CENTER)) * 0.6f)
+    const xy_pos_t ends[] = {
+      { _INSET(X, X_MIN_POS), _INSET(Y, Y_MIN_POS) }, { _INSET(X, X_MAX_POS), _INSET(Y, Y_MAX_POS) },
+      { _INSET(X, X_MIN_POS), _INSET(Y, Y_MAX_POS) }, { _INSET(X, X_MAX_POS), _INSET(Y, Y_MIN_POS) },
+      { X_CENTER, _INSET(Y, Y_MIN_POS) },             { X_CENTER, _INSET(Y, Y_MAX_POS) }
+    };
+    #undef _INSET
+    float worst = 0;
+    uint16_t points = 0;
+    for (uint8_t i = 0; i < COUNT(ends); i += 2) {
+      const xyz_pos_t start = { ends[i].x, ends[i].y, 1.0f }, end = { ends[i + 1].x, ends[i + 1].y, 1.0f };
+      if (!position_is_reachable(start) || !position_is_reachable(end)) continue;
+      const xyz_pos_t diff = end - start;
+      const uint16_t segments = _MAX(1U, uint16_t(diff.magnitude() / seg_mm));
+      const xyz_pos_t step = diff / float(segments);
+      xyz_pos_t raw = start;
+      for (uint16_t s = 0; s <= segments; ++s, raw += step) {
+        solve(raw, s > 0);
+        const abc_pos_t approx = { delta.a, delta.b, delta.c };
+        inverse_kinematics(raw);
+        NOLESS(worst, _MAX(ABS(delta.a - approx.a), ABS(delta.b - approx.b), ABS(delta.c - approx.c)));
+        ++points;
+      }
+    }
+    reset();
+    delta = saved_delta;
+    SERIAL_ECHOPGM("IK extrapolation test: ", points, " points, max error ");
+    SERIAL_ECHO_F(worst, 6);
+    SERIAL_ECHOPGM(" (interval ", IK_EXACT_INTERVAL, ", tolerance ");
+    SERIAL_ECHO_F(IK_EXTRAPOLATION_TOLERANCE, 6);
+    SERIAL_ECHOLNF(worst <= (IK_EXTRAPOLATION_TOLERANCE) ? F(") PASS") : F(") FAIL"));
+  }
+
+#endif // MARLIN_TEST_BUILD
+
+#endif // IK_EXTRAPOLATION
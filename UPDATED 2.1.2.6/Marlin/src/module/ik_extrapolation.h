@@ -0,0 +1,71 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2024 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * ik_extrapolation.h - Inverse kinematics by extrapolation
+ *
+ * The segments of a straight kinematic move are equally spaced, so each joint
+ * follows a smooth curve sampled at equal steps. Starting from a full solve,
+ * the joint motion per segment (the IK Jacobian applied to the segment vector)
+ * and its higher derivatives give the following joint positions by forward
+ * differencing, with three additions per joint instead of square roots and trig.
+ *
+ * DELTA gets the derivatives analytically from a single full solve. Other
+ * kinematics use the differences of five consecutive full solves.
+ * The cycle restarts with a full solve every IK_EXACT_INTERVAL segments, or
+ * sooner where the curvature would take the error past the tolerance.
+ */
+
+#include "../inc/MarlinConfig.h"
+
+class IKExtrapolation {
+  public:
+    static float max_error;   // Largest deviation found at a full solve, in mm or degrees
+
+    // Forget the history. The next solve will be a full solve.
+    static void reset() { phase = 0; }
+
+    /**
+     * Get the joint positions for 'raw', leaving the result in 'delta'.
+     * Set 'continue_line' only when 'raw' is the next equally-spaced
+     * point on the same straight line as the previous call.
+     */
+    static void solve(const xyz_pos_t &raw, const bool continue_line);
+
+    #if ENABLED(MARLIN_TEST_BUILD)
+      static void test();
+    #endif
+
+  private:
+    static abc_pos_t q,       // Last extrapolated position (DELTA: tower heights above the effector)
+                     d1, d2, d3;  // Forward differences
+    #if ENABLED(DELTA)
+      static xy_pos_t prev_xy;  // Effector XY of the previous segment
+    #else
+      static abc_pos_t anchor[4]; // First four full solves of the cycle
+    #endif
+    static uint8_t phase,     // Segments since the start of the cycle
+                   span;      // Segments per cycle, up to IK_EXACT_INTERVAL
+};
+
+extern IKExtrapolation ik_extrapolation;
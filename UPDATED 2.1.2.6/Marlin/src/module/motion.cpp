@@ -1148,9 +1148,11 @@ FORCE_INLINE void segment_idle(millis_t &next_idle_ms) {
       raw += segment_distance;
       if (!planner.buffer_line(raw, scaled_fr_mm_s, active_extruder, hints))
         break;
+      TERN_(IK_EXTRAPOLATION, hints.ik_extrapolate = true); // Following segments continue the line
     }
 
     // Ensure last segment arrives at target location.
+    TERN_(IK_EXTRAPOLATION, hints.ik_extrapolate = false);  // with a full IK solve
     planner.buffer_line(destination, scaled_fr_mm_s, active_extruder, hints);
 
     return false; // caller will update current_position
@@ -1462,6 +1464,12 @@ void prepare_line_to_destination() {
 
   main_axes_bits_t axes_homed, axes_trusted; // = 0
 
+  #if ENABLED(ADAPTIVE_HOMING)
+    homing_history_t homing_history; // Initialized by settings.load()
+    main_axes_bits_t axes_home_known; // = 0
+    static xyz_pos_t home_trigger_pos;       // Position of the bump trigger at the last homing
+  #endif
+
   main_axes_bits_t axes_should_home(main_axes_bits_t axis_bits/*=main_axes_mask*/) {
     auto set_should = [](main_axes_bits_t &b, AxisEnum a) {
       if (TEST(b, a) && TERN(HOME_AFTER_DEACTIVATE, axis_is_trusted, axis_was_homed)(a))
@@ -1939,6 +1947,26 @@ void prepare_line_to_destination() {
     }
   #endif
 
+  #if ENABLED(ADAPTIVE_HOMING)
+
+    // Add a fast stop offset measured by a bump cycle to the homing history
+    static void add_homing_sample(const AxisEnum axis, const float offset) {
+      float &avg = homing_history.fast_offset[axis];
+      uint8_t &n = homing_history.samples[axis];
+      if (n && ABS(offset - avg) <= (ADAPTIVE_HOMING_TOLERANCE)) {
+        avg += (offset - avg) * 0.25f;
+        if (n < 255) ++n;
+      }
+      else {
+        // Start over from this sample
+        avg = offset;
+        n = 1;
+      }
+      if (DEBUGGING(LEVELING)) DEBUG_ECHOLNPGM("Fast stop offset: ", offset, "mm (average ", avg, "mm, ", n, " samples)");
+    }
+
+  #endif
+
   /**
    * Home an individual "raw axis" to its endstop.
    * This applies to XYZ on Cartesian and Core robots, and
@@ -1971,6 +1999,15 @@ void prepare_line_to_destination() {
     const int axis_home_dir = TERN0(DUAL_X_CARRIAGE, axis == X_AXIS)
                 ? TOOL_X_HOME_DIR(active_extruder) : home_dir(axis);
 
+    #if ENABLED(ADAPTIVE_HOMING)
+      // With a good history and a trusted position the fast move should stop at a known spot
+      const bool use_history = TERN1(HOMING_Z_WITH_PROBE, axis != Z_AXIS) && home_bump_mm(axis);
+      bool predict = use_history && axis_is_trusted(axis) && TEST(axes_home_known, axis)
+                     && homing_history.samples[axis] >= (ADAPTIVE_HOMING_SAMPLES);
+      float fast_to_go = home_trigger_pos[axis] + homing_history.fast_offset[axis] - current_position[axis];
+      bool skip_bump = false;
+    #endif
+
     //
     // Homing Z with a probe? Raise Z (maybe) and deploy the Z probe.
     //
@@ -2007,6 +2044,7 @@ void prepare_line_to_destination() {
         const float backoff_length = -ABS(backoff[axis]) * axis_home_dir;
         if (DEBUGGING(LEVELING)) DEBUG_ECHOLNPGM("Sensorless backoff: ", backoff_length, "mm");
         do_homing_move(axis, backoff_length, homing_feedrate(axis));
+        TERN_(ADAPTIVE_HOMING, predict = false); // The backoff may stop early on a stall
       }
     #endif
 
@@ -2018,6 +2056,7 @@ void prepare_line_to_destination() {
         const AxisEnum opposite_axis = axis == X_AXIS ? Y_AXIS : X_AXIS;
         const float backoff_length = -ABS(XY_COUNTERPART_BACKOFF_MM) * home_dir(opposite_axis);
         do_homing_move(opposite_axis, backoff_length, homing_feedrate(opposite_axis));
+        TERN_(ADAPTIVE_HOMING, CBI(axes_home_known, opposite_axis)); // current_position wasn't moved
       }
     #endif
 
@@ -2028,6 +2067,37 @@ void prepare_line_to_destination() {
       use_probe_bump ? _MAX(TERN0(HOMING_Z_WITH_PROBE, Z_CLEARANCE_BETWEEN_PROBES), home_bump_mm(axis)) : home_bump_mm(axis)
     );
 
+    #if ENABLED(ADAPTIVE_HOMING)
+      //
+      // Travel faster than homing to near the expected trigger point. The endstop
+      // still stops the move if the position is off, so keep the speed modest.
+      //
+      if (predict) {
+        const float approach = fast_to_go - (ADAPTIVE_HOMING_APPROACH_MM) * axis_home_dir;
+        if (approach * axis_home_dir > 0) {
+          if (DEBUGGING(LEVELING)) DEBUG_ECHOLNPGM("Home Approach: ", approach, "mm");
+          // A relative move like do_homing_move, but with no check for a trigger
+          abce_pos_t target = planner.get_axis_positions_mm();
+          target[axis] = 0;
+          planner.set_machine_position_mm(target);
+          #if HAS_DIST_MM_ARG
+            const xyze_float_t cart_dist_mm{0};
+          #endif
+          target[axis] = approach;
+          const feedRate_t approach_fr = _MIN(homing_feedrate(axis) * (ADAPTIVE_HOMING_SPEEDUP), planner.settings.max_feedrate_mm_s[axis]);
+          planner.buffer_segment(target OPTARG(HAS_DIST_MM_ARG, cart_dist_mm), approach_fr, active_extruder);
+          planner.synchronize();
+          fast_to_go -= approach;
+          // The switch came early, so the history is no good. Home from here.
+          if (endstops.trigger_state()) {
+            endstops.hit_on_purpose();
+            homing_history.samples[axis] = 0;
+            predict = false;
+          }
+        }
+      }
+    #endif
+
     //
     // Fast move towards endstop until triggered
     //
@@ -2035,8 +2105,18 @@ void prepare_line_to_destination() {
     if (DEBUGGING(LEVELING)) DEBUG_ECHOLNPGM("Home Fast: ", move_length, "mm");
     do_homing_move(axis, move_length, 0.0, !use_probe_bump);
 
+    #if ENABLED(ADAPTIVE_HOMING)
+      // The homing move starts from 0, so its end is the distance moved
+      if (predict) {
+        const float deviation = planner.get_axis_position_mm(axis) - fast_to_go;
+        skip_bump = ABS(deviation) <= (ADAPTIVE_HOMING_TOLERANCE);
+        if (!skip_bump) homing_history.samples[axis] = 0; // Learn again from the bump cycle
+        if (DEBUGGING(LEVELING)) DEBUG_ECHOLNPGM("Fast hit deviation: ", deviation, "mm", skip_bump ? " (skip bump)" : "");
+      }
+    #endif
+
     // If a second homing move is configured...
-    if (bump) {
+    if (bump && !TERN0(ADAPTIVE_HOMING, skip_bump)) {
       #if ALL(HOMING_Z_WITH_PROBE, BLTOUCH)
         if (axis == Z_AXIS && !bltouch.high_speed_mode) bltouch.stow(); // Intermediate STOW (in LOW SPEED MODE)
       #endif
@@ -2078,6 +2158,9 @@ void prepare_line_to_destination() {
       const float rebump = bump * 2;
       if (DEBUGGING(LEVELING)) DEBUG_ECHOLNPGM("Re-bump: ", rebump, "mm");
       do_homing_move(axis, rebump, get_homing_bump_feedrate(axis), true);
+
+      // The fast move stopped 'bump' before the start of the re-bump
+      TERN_(ADAPTIVE_HOMING, if (use_history) add_homing_sample(axis, bump - planner.get_axis_position_mm(axis)));
     }
 
     #if ALL(HOMING_Z_WITH_PROBE, BLTOUCH)
@@ -2247,6 +2330,17 @@ void prepare_line_to_destination() {
     #else // CARTESIAN / CORE / MARKFORGED_XY / MARKFORGED_YX
 
       set_axis_is_at_home(axis);
+
+      #if ENABLED(ADAPTIVE_HOMING)
+        home_trigger_pos[axis] = current_position[axis];
+        SBI(axes_home_known, axis);
+        // Without the bump the carriage stopped past the trigger point
+        if (skip_bump) current_position[axis] += homing_history.fast_offset[axis];
+      #endif
+
+      // The endstop is at home. The carriage stopped short of it by the part of a step not yet taken.
+      TERN_(ENDSTOP_INPUT_CAPTURE, current_position[axis] -= stepper.triggered_substep(axis) * planner.mm_per_step[axis]);
+
       sync_plan_position();
 
       destination[axis] = current_position[axis];
@@ -2360,6 +2454,7 @@ void set_axis_is_at_home(const AxisEnum axis) {
 #if HAS_WORKSPACE_OFFSET
   void update_workspace_offset(const AxisEnum axis) {
     workspace_offset[axis] = home_offset[axis] + position_shift[axis];
+    TERN_(ADAPTIVE_HOMING, CBI(axes_home_known, axis)); // Don't aim for the last trigger across an offset change
     if (DEBUGGING(LEVELING)) DEBUG_ECHOLNPGM("Axis ", C(AXIS_CHAR(axis)), " home_offset = ", home_offset[axis], " position_shift = ", position_shift[axis]);
   }
 #endif
@@ -458,6 +458,15 @@ inline bool all_axes_trusted()                        { return main_axes_mask ==
 
 void home_if_needed(const bool keeplev=false);
 
+#if ENABLED(ADAPTIVE_HOMING)
+  typedef struct {
+    xyz_float_t fast_offset;  // Distance the fast homing move stops past the bump trigger point
+    xyz_uint8_t samples;      // Consistent bump cycles behind fast_offset
+  } homing_history_t;
+  extern homing_history_t homing_history;
+  extern main_axes_bits_t axes_home_known;  // Axes whose current_position is still relative to the last trigger
+#endif
+
 #if ENABLED(NO_MOTION_BEFORE_HOMING)
   #define MOTION_CONDITIONS (IsRunning() && !homing_needed_error())
 #else
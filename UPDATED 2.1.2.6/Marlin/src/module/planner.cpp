@@ -110,6 +110,14 @@
   #include "../feature/spindle_laser.h"
 #endif
 
+#if ENABLED(IK_EXTRAPOLATION)
+  #include "ik_extrapolation.h"
+#endif
+
+#if ALL(SLOWDOWN_ADAPTIVE, MOTION_TELEMETRY)
+  #include "../feature/motion_telemetry.h"
+#endif
+
 // Delay for delivery of first block to the stepper ISR, if the queue contains 2 or
 // fewer movements. The delay is measured in milliseconds, and must be less than 250ms
 #define BLOCK_DELAY_FOR_1ST_MOVE 100U
@@ -240,10 +248,15 @@ float Planner::previous_nominal_speed;
   xyze_pos_t Planner::position_cart;
 #endif
 
-#if HAS_WIRED_LCD
+#if HAS_BLOCK_RUNTIME
   volatile uint32_t Planner::block_buffer_runtime_us = 0;
 #endif
 
+#if ENABLED(SLOWDOWN_ADAPTIVE)
+  uint32_t Planner::feed_interval_us; // = 0
+  millis_t Planner::last_feed_ms;     // = 0
+#endif
+
 /**
  * Class and Instance Methods
  */
@@ -756,7 +769,7 @@ block_t* Planner::get_current_block() {
     if (block->flag.recalculate) return nullptr;
 
     // We can't be sure how long an active block will take, so don't count it.
-    TERN_(HAS_WIRED_LCD, block_buffer_runtime_us -= block->segment_time_us);
+    TERN_(HAS_BLOCK_RUNTIME, block_buffer_runtime_us -= block->segment_time_us);
 
     // As this block is busy, advance the nonbusy block pointer
     block_buffer_nonbusy = next_block_index(block_buffer_tail);
@@ -770,7 +783,7 @@ block_t* Planner::get_current_block() {
   }
 
   // The queue became empty
-  TERN_(HAS_WIRED_LCD, clear_block_buffer_runtime()); // paranoia. Buffer is empty now - so reset accumulated time to zero.
+  TERN_(HAS_BLOCK_RUNTIME, clear_block_buffer_runtime()); // paranoia. Buffer is empty now - so reset accumulated time to zero.
 
   return nullptr;
 }
@@ -845,6 +858,39 @@ void Planner::calculate_trapezoid_for_block(block_t * const block, const_float_t
              deceleration_time_inverse = get_period_inverse(deceleration_time);
   #endif
 
+  #if ENABLED(SHAPING_TRAPEZOID)
+    /**
+     * Convolve the trapezoid with the shaper of the moving axes. The shaped speed lags
+     * the reference trapezoid, so shorten the reference by the steps covered during the
+     * lag at the entry and exit rates. The shaped profile then reaches final_rate on the
+     * last step of the block. Blocks too short for that keep the plain trapezoid.
+     */
+    block->shaper = 0;
+    const uint8_t shaped_axes = (block->steps.x ? 1 : 0) | (block->steps.y ? 2 : 0);
+    if (shaped_axes && accel) {
+      const trapezoid_shaper_t &shaper = stepper.trapezoid_shaper(shaped_axes);
+      if (shaper.count > 1) {
+        constexpr float ticks_to_s = 1.0f / (STEPPER_TIMER_RATE);
+        const float lag = shaper.mean * ticks_to_s,
+                    tail = (shaper.duration - shaper.mean) * ticks_to_s,
+                    ref_steps = block->step_event_count - initial_rate * lag - final_rate * tail,
+                    half_inverse_accel = 0.5f * inverse_accel,
+                    initial_sq = sq(float(initial_rate)), final_sq = sq(float(final_rate));
+        float peak_sq = sq(float(block->nominal_rate));
+        if (half_inverse_accel * (2 * peak_sq - initial_sq - final_sq) > ref_steps)
+          peak_sq = accel * ref_steps + 0.5f * (initial_sq + final_sq);
+        if (ref_steps > 0 && peak_sq >= _MAX(initial_sq, final_sq)) {
+          const float peak = SQRT(peak_sq), rate_factor = inverse_accel * (STEPPER_TIMER_RATE),
+                      cruise_steps = _MAX(0.0f, ref_steps - half_inverse_accel * (2 * peak_sq - initial_sq - final_sq));
+          block->shaped_accel_ticks = rate_factor * (peak - initial_rate);
+          block->shaped_decel_ticks = rate_factor * (peak - final_rate);
+          block->shaped_decel_start_ticks = block->shaped_accel_ticks + cruise_steps * (STEPPER_TIMER_RATE) / peak;
+          block->shaper = shaped_axes;
+        }
+      }
+    }
+  #endif
+
   // Store new block parameters
   block->accelerate_until = accelerate_steps;
   block->decelerate_after = block->step_event_count - decelerate_steps;
@@ -863,6 +909,33 @@ void Planner::calculate_trapezoid_for_block(block_t * const block, const_float_t
       const float comp = extruder_advance_K[E_INDEX_N(block->extruder)] * block->steps.e / block->step_event_count;
       block->max_adv_steps = cruise_rate * comp;
       block->final_adv_steps = final_rate * comp;
+
+      #if ENABLED(SMOOTH_LIN_ADVANCE)
+        /**
+         * The advance rate follows the acceleration averaged over a window centered on
+         * the current time, so it ramps through each change of acceleration within the
+         * block. Outside the block the acceleration is taken to go on as at its start and
+         * end. That leaves the advance at each junction where it would be without the
+         * smoothing, so no error can build up from block to block. Phases shorter than
+         * half the window overshoot a little and are stopped by the advance limits.
+         */
+        const float la_rate_factor = inverse_accel * (STEPPER_TIMER_RATE);
+        const int32_t accel_ticks = accelerate_steps ? int32_t(la_rate_factor * float(cruise_rate - initial_rate)) : 0,
+                      cruise_ticks = plateau_steps > 0 ? int32_t(float(plateau_steps) * (STEPPER_TIMER_RATE) / cruise_rate) : 0;
+        if (!accelerate_steps)
+          block->la_accel_end = 0;                                        // No accelerating advance
+        else if (!decelerate_steps && plateau_steps <= 0)
+          block->la_accel_end = INT32_MAX;                                // Accelerating to the end
+        else
+          block->la_accel_end = accel_ticks + la_smooth_ticks / 2;
+
+        if (!decelerate_steps)
+          block->la_decel_start = INT32_MAX;                              // No decelerating advance
+        else if (!accelerate_steps && plateau_steps <= 0)
+          block->la_decel_start = -la_smooth_ticks;                       // Decelerating from the start
+        else
+          block->la_decel_start = accel_ticks + cruise_ticks - la_smooth_ticks / 2;
+      #endif
     }
   #endif
 
@@ -1692,7 +1765,7 @@ void Planner::quick_stop() {
   // forced to empty, there's no risk the ISR will touch this.
   delay_before_delivering = BLOCK_DELAY_FOR_1ST_MOVE;
 
-  TERN_(HAS_WIRED_LCD, clear_block_buffer_runtime()); // Clear the accumulated runtime
+  TERN_(HAS_BLOCK_RUNTIME, clear_block_buffer_runtime()); // Clear the accumulated runtime
 
   // Make sure to drop any attempt of queuing moves for 1 second
   cleaning_buffer_counter = TEMP_TIMER_FREQUENCY;
@@ -1729,13 +1802,13 @@ void Planner::endstop_triggered(const AxisEnum axis) {
 
 float Planner::triggered_position_mm(const AxisEnum axis) {
   const float result = DIFF_TERN(BACKLASH_COMPENSATION, stepper.triggered_position(axis), backlash.get_applied_steps(axis));
-  return result * mm_per_step[axis];
+  return (result + TERN0(ENDSTOP_INPUT_CAPTURE, stepper.triggered_substep(axis))) * mm_per_step[axis];
 }
 
 bool Planner::busy() {
   return (has_blocks_queued() || cleaning_buffer_counter
       || TERN0(EXTERNAL_CLOSED_LOOP_CONTROLLER, CLOSED_LOOP_WAITING())
-      || TERN0(HAS_ZV_SHAPING, stepper.input_shaping_busy())
+      || TERN0(HAS_SHAPING_ECHOES, stepper.input_shaping_busy())
   );
 }
 
@@ -1820,6 +1893,9 @@ bool Planner::_buffer_steps(const xyze_long_t &target
   , feedRate_t fr_mm_s, const uint8_t extruder, const PlannerHints &hints
 ) {
 
+  // Measure the feed rate of blocks before waiting for a free one
+  TERN_(SLOWDOWN_ADAPTIVE, update_feed_interval());
+
   // Wait for the next available block
   uint8_t next_buffer_head;
   block_t * const block = get_next_free_block(next_buffer_head);
@@ -1854,6 +1930,8 @@ bool Planner::_buffer_steps(const xyze_long_t &target
   // Move buffer head
   block_buffer_head = next_buffer_head;
 
+  TERN_(SLOWDOWN_ADAPTIVE, last_feed_ms = millis());
+
   // Recalculate and optimize trapezoidal speed profiles
   recalculate(TERN_(HINTS_SAFE_EXIT_SPEED, hints.safe_exit_speed_sqr));
 
@@ -1861,6 +1939,22 @@ bool Planner::_buffer_steps(const xyze_long_t &target
   return true;
 }
 
+#if ENABLED(SLOWDOWN_ADAPTIVE)
+
+  /**
+   * Average the time the host or SD card takes to deliver each block.
+   * Called before waiting for a free block, so the wait isn't counted.
+   * Gaps while the queue is empty are ignored, and long gaps (e.g., G4)
+   * are capped so they don't slow down the moves that follow for long.
+   */
+  void Planner::update_feed_interval() {
+    if (!has_blocks_queued()) return;
+    const uint32_t sample_us = _MIN(millis() - last_feed_ms, millis_t(SLOWDOWN_RESERVE_MS)) * 1000UL;
+    feed_interval_us = (feed_interval_us * 7 + sample_us) >> 3;
+  }
+
+#endif
+
 /**
  * @brief Populate a block in preparation for insertion
  * @details Populate the fields of a new linear movement block
@@ -2373,7 +2467,31 @@ bool Planner::_populate_block(
     int32_t segment_time_us = LROUND(1000000.0f / inverse_secs);
   #endif
 
-  #if ENABLED(SLOWDOWN)
+  #if ENABLED(SLOWDOWN_ADAPTIVE)
+    /**
+     * Blocks arrive every feed_interval_us and the queue holds block_buffer_runtime()
+     * of motion after the busy block. Each new block adds its own time to the queue,
+     * so the queue drains whenever blocks are shorter than the feed interval.
+     * Predict an underrun when the queued time falls below the reserve, and stretch
+     * the block to the feed interval, up to double that as the reserve runs out.
+     */
+    const int32_t short_ms = (SLOWDOWN_RESERVE_MS) - int32_t(block_buffer_runtime());
+    if (moves_queued && short_ms > 0) {
+      const float target_us = feed_interval_us * (1.0f + float(short_ms) / (SLOWDOWN_RESERVE_MS));
+      if (segment_time_us < target_us) {
+        const float factor = _MAX(float(SLOWDOWN_MIN_FACTOR), segment_time_us / target_us);
+        segment_time_us = LROUND(segment_time_us / factor);
+        inverse_secs *= factor;
+        #if ENABLED(MOTION_TELEMETRY)
+          if (motion_telemetry.enabled) {
+            const bool was_enabled = stepper.suspend();
+            motion_telemetry.slowdown(block_buffer_runtime(), feed_interval_us, factor);
+            if (was_enabled) stepper.wake_up();
+          }
+        #endif
+      }
+    }
+  #elif ENABLED(SLOWDOWN)
     #ifndef SLOWDOWN_DIVISOR
       #define SLOWDOWN_DIVISOR 2
     #endif
@@ -2383,14 +2501,14 @@ bool Planner::_populate_block(
         // Buffer is draining so add extra time. The amount of time added increases if the buffer is still emptied more.
         const int32_t nst = segment_time_us + LROUND(2 * time_diff / moves_queued);
         inverse_secs = 1000000.0f / nst;
-        #if defined(XY_FREQUENCY_LIMIT) || HAS_WIRED_LCD
+        #if defined(XY_FREQUENCY_LIMIT) || HAS_BLOCK_RUNTIME
           segment_time_us = nst;
         #endif
       }
     }
   #endif
 
-  #if HAS_WIRED_LCD
+  #if HAS_BLOCK_RUNTIME
     // Protect the access to the position.
     const bool was_enabled = stepper.suspend();
 
@@ -2605,6 +2723,10 @@ bool Planner::_populate_block(
       for (uint32_t dividend = block->steps.e << 1; dividend <= (block->step_event_count >> 2); dividend <<= 1)
         block->la_scaling++;
 
+      #if ENABLED(SMOOTH_LIN_ADVANCE)
+        block->la_ramp_rate = block->la_advance_rate * (float(1UL << 24) / la_smooth_ticks);
+      #endif
+
       #if ENABLED(LA_DEBUG)
         if (block->la_advance_rate >> block->la_scaling > 10000)
           SERIAL_ECHOLNPGM("eISR running at > 10kHz: ", block->la_advance_rate);
@@ -3158,7 +3280,11 @@ bool Planner::buffer_line(const xyze_pos_t &cart, const_feedRate_t fr_mm_s
     #endif
 
     // Cartesian XYZ to kinematic ABC, stored in global 'delta'
-    inverse_kinematics(machine);
+    #if ENABLED(IK_EXTRAPOLATION)
+      ik_extrapolation.solve(machine, hints.ik_extrapolate);
+    #else
+      inverse_kinematics(machine);
+    #endif
 
     PlannerHints ph = hints;
     if (!hints.millimeters)
@@ -3424,7 +3550,7 @@ void Planner::set_max_feedrate(const AxisEnum axis, float inMaxFeedrateMMS) {
 
 #endif
 
-#if HAS_WIRED_LCD
+#if HAS_BLOCK_RUNTIME
 
   uint16_t Planner::block_buffer_runtime() {
     #ifdef __AVR__
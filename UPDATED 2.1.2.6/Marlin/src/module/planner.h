@@ -178,6 +178,11 @@ typedef struct {
 
 #endif
 
+#if ENABLED(SMOOTH_LIN_ADVANCE)
+  // Width of the Linear Advance smoothing window in STEP timer counts
+  constexpr int32_t la_smooth_ticks = (LIN_ADVANCE_SMOOTH_TIME) * (STEPPER_TIMER_RATE);
+#endif
+
 /**
  * struct block_t
  *
@@ -234,6 +239,13 @@ typedef struct PlannerBlock {
     uint32_t acceleration_rate;             // The acceleration rate used for acceleration calculation
   #endif
 
+  #if ENABLED(SHAPING_TRAPEZOID)
+    uint8_t shaper;                         // Trapezoid shaper for the moving axes (X=1, Y=2, both=3), 0 if unshaped
+    uint32_t shaped_accel_ticks,            // Reference trapezoid acceleration time in STEP timer counts
+             shaped_decel_start_ticks,      // Reference trapezoid time at which deceleration starts
+             shaped_decel_ticks;            // Reference trapezoid deceleration time
+  #endif
+
   axis_bits_t direction_bits;               // The direction bit set for this block (refers to *_DIRECTION_BIT in config.h)
 
   // Advance extrusion
@@ -242,6 +254,11 @@ typedef struct PlannerBlock {
     uint8_t  la_scaling;                    // Scale ISR frequency down and step frequency up by 2 ^ la_scaling
     uint16_t max_adv_steps,                 // Max advance steps to get cruising speed pressure
              final_adv_steps;               // Advance steps for exit speed pressure
+    #if ENABLED(SMOOTH_LIN_ADVANCE)
+      uint32_t la_ramp_rate;                // Change of the advance rate per STEP timer count in a ramp (<< 24)
+      int32_t  la_accel_end,                // Time the ramp down from accelerating advance ends, in STEP timer counts
+               la_decel_start;              // Time the ramp into decelerating advance starts
+    #endif
   #endif
 
   uint32_t nominal_rate,                    // The nominal step rate for this block in step_events/sec
@@ -265,7 +282,7 @@ typedef struct PlannerBlock {
     uint8_t valve_pressure, e_to_p_pressure;
   #endif
 
-  #if HAS_WIRED_LCD
+  #if HAS_BLOCK_RUNTIME
     uint32_t segment_time_us;
   #endif
 
@@ -381,6 +398,10 @@ struct PlannerHints {
                                       // i.e., at or below the exit speed of the segment that the planner
                                       // would calculate if it knew the as-yet-unbuffered path
   #endif
+  #if ENABLED(IK_EXTRAPOLATION)
+    bool ik_extrapolate = false;      // The segment continues the previous one on a straight line
+                                      // with equal spacing, so the IK may be extrapolated
+  #endif
 
   PlannerHints(const_float_t mm=0.0f) : millimeters(mm) {}
 };
@@ -537,10 +558,16 @@ class Planner {
       static last_move_t g_uc_extruder_last_move[E_STEPPERS];
     #endif
 
-    #if HAS_WIRED_LCD
+    #if HAS_BLOCK_RUNTIME
       volatile static uint32_t block_buffer_runtime_us; // Theoretical block buffer runtime in µs
     #endif
 
+    #if ENABLED(SLOWDOWN_ADAPTIVE)
+      static uint32_t feed_interval_us;               // Average time between new blocks while moving
+      static millis_t last_feed_ms;                   // Time the last block was queued
+      static void update_feed_interval();
+    #endif
+
   public:
 
     /**
@@ -978,7 +1005,7 @@ class Planner {
         block_buffer_tail = next_block_index(block_buffer_tail);
     }
 
-    #if HAS_WIRED_LCD
+    #if HAS_BLOCK_RUNTIME
       static uint16_t block_buffer_runtime();
       static void clear_block_buffer_runtime();
     #endif
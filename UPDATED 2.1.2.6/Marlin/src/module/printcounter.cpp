@@ -45,6 +45,10 @@ Stopwatch print_job_timer;      // Global Print Job Timer instance
   #include "../module/planner.h"
 #endif
 
+#if ENABLED(SD_JOB_ESTIMATE)
+  #include "../feature/job_estimate.h"
+#endif
+
 // Service intervals
 #if HAS_SERVICE_INTERVALS
   #if SERVICE_INTERVAL_1 > 0
@@ -223,6 +227,24 @@ void PrintCounter::showStats() {
 
   SERIAL_EOL();
 
+  #if ENABLED(SD_JOB_ESTIMATE)
+    // The job being printed, once its scan is complete
+    if (job_estimate.complete && (isRunning() || isPaused())) {
+      SERIAL_ECHOPGM(STR_STATS);
+      elapsed = uint32_t(job_estimate.seconds);
+      elapsed.toString(buffer);
+      SERIAL_ECHOPGM("Job estimate: ", buffer);
+      elapsed = job_estimate.remaining();
+      elapsed.toString(buffer);
+      SERIAL_ECHOPGM(", Left: ", buffer);
+      #if HAS_EXTRUDERS
+        SERIAL_ECHOPGM(", Filament: ", job_estimate.filament_mm / 1000);
+        SERIAL_CHAR('m');
+      #endif
+      SERIAL_EOL();
+    }
+  #endif
+
   #if SERVICE_INTERVAL_1 > 0
     _service_when(buffer, PSTR(SERVICE_NAME_1), data.nextService1);
   #endif
@@ -74,6 +74,10 @@
   #include "../feature/backlash.h"
 #endif
 
+#if ENABLED(ENDSTOP_INPUT_CAPTURE)
+  #include "stepper.h"
+#endif
+
 #if ENABLED(BLTOUCH)
   #include "../feature/bltouch.h"
 #endif
@@ -655,6 +659,11 @@ bool Probe::probe_down_to_z(const_float_t z, const_feedRate_t fr_mm_s) {
   // Get Z where the steppers were interrupted
   set_current_from_steppers_for_axis(Z_AXIS);
 
+  #if ENABLED(ENDSTOP_INPUT_CAPTURE) && !IS_KINEMATIC
+    // Add the part of a step moved before the probe triggered
+    if (probe_triggered) current_position.z += stepper.triggered_substep(Z_AXIS) * planner.mm_per_step[Z_AXIS];
+  #endif
+
   // Tell the planner where we actually are
   sync_plan_position();
 
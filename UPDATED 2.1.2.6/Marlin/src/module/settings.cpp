@@ -592,10 +592,23 @@ typedef struct SettingsDataStruct {
   #if ENABLED(INPUT_SHAPING_X)
     float shaping_x_frequency,                          // M593 X F
           shaping_x_zeta;                               // M593 X D
+    #if ENABLED(SHAPING_MULTI_IMPULSE)
+      uint8_t shaping_x_type;                           // M593 X T
+    #endif
   #endif
   #if ENABLED(INPUT_SHAPING_Y)
     float shaping_y_frequency,                          // M593 Y F
           shaping_y_zeta;                               // M593 Y D
+    #if ENABLED(SHAPING_MULTI_IMPULSE)
+      uint8_t shaping_y_type;                           // M593 Y T
+    #endif
+  #endif
+
+  //
+  // Adaptive Homing
+  //
+  #if ENABLED(ADAPTIVE_HOMING)
+    homing_history_t homing_history;                    // G28 learned fast stop offsets
   #endif
 
 } SettingsData;
@@ -1661,13 +1674,27 @@ void MarlinSettings::postprocess() {
       #if ENABLED(INPUT_SHAPING_X)
         EEPROM_WRITE(stepper.get_shaping_frequency(X_AXIS));
         EEPROM_WRITE(stepper.get_shaping_damping_ratio(X_AXIS));
+        #if ENABLED(SHAPING_MULTI_IMPULSE)
+          EEPROM_WRITE(uint8_t(stepper.get_shaping_type(X_AXIS)));
+        #endif
       #endif
       #if ENABLED(INPUT_SHAPING_Y)
         EEPROM_WRITE(stepper.get_shaping_frequency(Y_AXIS));
         EEPROM_WRITE(stepper.get_shaping_damping_ratio(Y_AXIS));
+        #if ENABLED(SHAPING_MULTI_IMPULSE)
+          EEPROM_WRITE(uint8_t(stepper.get_shaping_type(Y_AXIS)));
+        #endif
       #endif
     #endif
 
+    //
+    // Adaptive Homing
+    //
+    #if ENABLED(ADAPTIVE_HOMING)
+      _FIELD_TEST(homing_history);
+      EEPROM_WRITE(homing_history);
+    #endif
+
     //
     // Report final CRC and Data Size
     //
@@ -2709,6 +2736,11 @@ void MarlinSettings::postprocess() {
       {
         float _data[2];
         EEPROM_READ(_data);
+        #if ENABLED(SHAPING_MULTI_IMPULSE)
+          uint8_t shaping_type;
+          EEPROM_READ(shaping_type);
+          stepper.set_shaping_type(X_AXIS, ShapingType(_MIN(shaping_type, SHAPER_COUNT - 1)));
+        #endif
         stepper.set_shaping_frequency(X_AXIS, _data[0]);
         stepper.set_shaping_damping_ratio(X_AXIS, _data[1]);
       }
@@ -2718,11 +2750,24 @@ void MarlinSettings::postprocess() {
       {
         float _data[2];
         EEPROM_READ(_data);
+        #if ENABLED(SHAPING_MULTI_IMPULSE)
+          uint8_t shaping_type;
+          EEPROM_READ(shaping_type);
+          stepper.set_shaping_type(Y_AXIS, ShapingType(_MIN(shaping_type, SHAPER_COUNT - 1)));
+        #endif
         stepper.set_shaping_frequency(Y_AXIS, _data[0]);
         stepper.set_shaping_damping_ratio(Y_AXIS, _data[1]);
       }
       #endif
 
+      //
+      // Adaptive Homing
+      //
+      #if ENABLED(ADAPTIVE_HOMING)
+        _FIELD_TEST(homing_history);
+        EEPROM_READ(homing_history);
+      #endif
+
       //
       // Validate Final Size and CRC
       //
@@ -3507,14 +3552,24 @@ void MarlinSettings::reset() {
   #if HAS_ZV_SHAPING
     #if ENABLED(INPUT_SHAPING_X)
       stepper.set_shaping_frequency(X_AXIS, SHAPING_FREQ_X);
+      stepper.set_shaping_type(X_AXIS, ShapingType(SHAPING_TYPE_X));
       stepper.set_shaping_damping_ratio(X_AXIS, SHAPING_ZETA_X);
     #endif
     #if ENABLED(INPUT_SHAPING_Y)
       stepper.set_shaping_frequency(Y_AXIS, SHAPING_FREQ_Y);
+      stepper.set_shaping_type(Y_AXIS, ShapingType(SHAPING_TYPE_Y));
       stepper.set_shaping_damping_ratio(Y_AXIS, SHAPING_ZETA_Y);
     #endif
   #endif
 
+  //
+  // Adaptive Homing
+  //
+  #if ENABLED(ADAPTIVE_HOMING)
+    homing_history.fast_offset.reset();
+    homing_history.samples.reset();
+  #endif
+
   postprocess();
 
   #if ANY(EEPROM_CHITCHAT, DEBUG_LEVELING_FEATURE)
@@ -133,6 +133,14 @@ Stepper stepper; // Singleton
   #include "../feature/spindle_laser.h"
 #endif
 
+#if ENABLED(MOTION_TELEMETRY)
+  #include "../feature/motion_telemetry.h"
+#endif
+
+#if ENABLED(CPU_PROFILER)
+  #include "../feature/cpu_profiler.h"
+#endif
+
 #if ENABLED(EXTENSIBLE_UI)
   #include "../lcd/extui/ui_api.h"
 #endif
@@ -230,32 +238,44 @@ uint32_t Stepper::advance_divisor = 0,
   int32_t  Stepper::la_delta_error = 0,
            Stepper::la_dividend = 0,
            Stepper::la_advance_steps = 0;
+  #if ENABLED(SMOOTH_LIN_ADVANCE)
+    int32_t Stepper::la_elapsed = 0;
+  #endif
 #endif
 
-#if HAS_ZV_SHAPING
+#if HAS_SHAPING_ECHOES
   shaping_time_t      ShapingQueue::now = 0;
   shaping_time_t      ShapingQueue::times[shaping_echoes];
   shaping_echo_axis_t ShapingQueue::echo_axes[shaping_echoes];
   uint16_t            ShapingQueue::tail = 0;
 
   #if ENABLED(INPUT_SHAPING_X)
-    shaping_time_t  ShapingQueue::delay_x;
-    shaping_time_t  ShapingQueue::peek_x_val = shaping_time_t(-1);
-    uint16_t        ShapingQueue::head_x = 0;
+    shaping_time_t  ShapingQueue::delay_x[shaping_echo_heads];
+    shaping_time_t  ShapingQueue::peek_x_val[shaping_echo_heads] = { shaping_time_t(-1) };
+    uint16_t        ShapingQueue::head_x[shaping_echo_heads] = { 0 };
     uint16_t        ShapingQueue::_free_count_x = shaping_echoes - 1;
-    ShapeParams     Stepper::shaping_x;
+    uint8_t         ShapingQueue::heads_x = 1;
   #endif
   #if ENABLED(INPUT_SHAPING_Y)
-    shaping_time_t  ShapingQueue::delay_y;
-    shaping_time_t  ShapingQueue::peek_y_val = shaping_time_t(-1);
-    uint16_t        ShapingQueue::head_y = 0;
+    shaping_time_t  ShapingQueue::delay_y[shaping_echo_heads];
+    shaping_time_t  ShapingQueue::peek_y_val[shaping_echo_heads] = { shaping_time_t(-1) };
+    uint16_t        ShapingQueue::head_y[shaping_echo_heads] = { 0 };
     uint16_t        ShapingQueue::_free_count_y = shaping_echoes - 1;
-    ShapeParams     Stepper::shaping_y;
+    uint8_t         ShapingQueue::heads_y = 1;
   #endif
 #endif
 
+#if HAS_ZV_SHAPING
+  TERN_(INPUT_SHAPING_X, ShapeParams Stepper::shaping_x);
+  TERN_(INPUT_SHAPING_Y, ShapeParams Stepper::shaping_y);
+  TERN_(SHAPING_TRAPEZOID, trapezoid_shaper_t Stepper::trapezoid_shapers[3]);
+#endif
+
 #if ENABLED(INTEGRATED_BABYSTEPPING)
   uint32_t Stepper::nextBabystepISR = BABYSTEP_NEVER;
+  #if ENABLED(BABYSTEP_SMOOTH)
+    int8_t Stepper::babystep_z_fold; // = 0
+  #endif
 #endif
 
 #if ENABLED(DIRECT_STEPPING)
@@ -268,6 +288,12 @@ int32_t Stepper::ticks_nominal = -1;
 #endif
 
 xyz_long_t Stepper::endstops_trigsteps;
+#if ENABLED(ENDSTOP_INPUT_CAPTURE)
+  xyz_float_t Stepper::endstops_trigsub;
+  int32_t Stepper::pulse_ticks, Stepper::edge_ticks;
+  uint32_t Stepper::pulse_interval;
+  bool Stepper::edge_captured; // = false
+#endif
 xyze_long_t Stepper::count_position{0};
 xyze_int8_t Stepper::count_direction{0};
 
@@ -633,6 +659,15 @@ void Stepper::apply_directions() {
   #endif
 
   DIR_WAIT_AFTER();
+
+  #if ENABLED(BABYSTEP_SMOOTH)
+    // The Z direction of a waiting babystep was just overwritten. Set it again
+    // from the babystep phase, with the time to settle before the next pulse.
+    if (babystep_z_fold) {
+      babystep_z_fold = 0;
+      nextBabystepISR = 0;
+    }
+  #endif
 }
 
 #if ENABLED(S_CURVE_ACCELERATION)
@@ -1457,6 +1492,7 @@ HAL_STEP_TIMER_ISR() {
 #define STEP_MULTIPLY(A,B) TERN(CPU_32_BIT, MultiU32X24toH32, MultiU24X32toH16)(A, B)
 
 void Stepper::isr() {
+  TERN_(CPU_PROFILER, PROFILE_SCOPE(STEPPER_ISR));
 
   static uint32_t nextMainISR = 0;  // Interval until the next main Stepper Pulse phase (0 = Now)
 
@@ -1483,9 +1519,12 @@ void Stepper::isr() {
     // Enable ISRs to reduce USART processing latency
     hal.isr_on();
 
-    TERN_(HAS_ZV_SHAPING, shaping_isr());               // Do Shaper stepping, if needed
+    TERN_(HAS_SHAPING_ECHOES, shaping_isr());           // Do Shaper stepping, if needed
 
-    if (!nextMainISR) pulse_phase_isr();                // 0 = Do coordinated axes Stepper pulses
+    if (!nextMainISR) {                                 // 0 = Do coordinated axes Stepper pulses
+      pulse_phase_isr();
+      TERN_(ENDSTOP_INPUT_CAPTURE, pulse_ticks = -int32_t(next_isr_ticks)); // Date captured edges from this pulse
+    }
 
     #if ENABLED(LIN_ADVANCE)
       if (!nextAdvanceISR) {                            // 0 = Do Linear Advance E Stepper pulses
@@ -1503,10 +1542,13 @@ void Stepper::isr() {
 
     // ^== Time critical. NOTHING besides pulse generation should be above here!!!
 
-    if (!nextMainISR) nextMainISR = block_phase_isr();  // Manage acc/deceleration, get next block
+    if (!nextMainISR) {                                 // Manage acc/deceleration, get next block
+      nextMainISR = block_phase_isr();
+      TERN_(ENDSTOP_INPUT_CAPTURE, pulse_interval = nextMainISR);
+    }
 
     #if ENABLED(INTEGRATED_BABYSTEPPING)
-      if (is_babystep)                                  // Avoid ANY stepping too soon after baby-stepping
+      if (is_babystep && TERN1(BABYSTEP_SMOOTH, !babystep_z_fold)) // Avoid ANY stepping too soon after baby-stepping
         NOLESS(nextMainISR, (BABYSTEP_TICKS) / 8);      // FULL STOP for 125µs after a baby-step
 
       if (nextBabystepISR != BABYSTEP_NEVER)            // Avoid baby-stepping too close to axis Stepping
@@ -1517,8 +1559,8 @@ void Stepper::isr() {
     const uint32_t interval = _MIN(
       uint32_t(HAL_TIMER_TYPE_MAX),                           // Come back in a very long time
       nextMainISR                                             // Time until the next Pulse / Block phase
-      OPTARG(INPUT_SHAPING_X, ShapingQueue::peek_x())         // Time until next input shaping echo for X
-      OPTARG(INPUT_SHAPING_Y, ShapingQueue::peek_y())         // Time until next input shaping echo for Y
+      OPTARG(HAS_SHAPING_ECHO_X, ShapingQueue::peek_x())      // Time until next input shaping echo for X
+      OPTARG(HAS_SHAPING_ECHO_Y, ShapingQueue::peek_y())      // Time until next input shaping echo for Y
       OPTARG(LIN_ADVANCE, nextAdvanceISR)                     // Come back early for Linear Advance?
       OPTARG(INTEGRATED_BABYSTEPPING, nextBabystepISR)        // Come back early for Babystepping?
     );
@@ -1531,7 +1573,7 @@ void Stepper::isr() {
     //
 
     nextMainISR -= interval;
-    TERN_(HAS_ZV_SHAPING, ShapingQueue::decrement_delays(interval));
+    TERN_(HAS_SHAPING_ECHOES, ShapingQueue::decrement_delays(interval));
     TERN_(LIN_ADVANCE, if (nextAdvanceISR != LA_ADV_NEVER) nextAdvanceISR -= interval);
     TERN_(INTEGRATED_BABYSTEPPING, if (nextBabystepISR != BABYSTEP_NEVER) nextBabystepISR -= interval);
 
@@ -1596,6 +1638,11 @@ void Stepper::isr() {
   // Set the next ISR to fire at the proper time
   HAL_timer_set_compare(MF_TIMER_STEP, hal_timer_t(next_isr_ticks));
 
+  TERN_(MOTION_TELEMETRY, motion_telemetry.isr_done(next_isr_ticks, max_loops));
+
+  // The step timer count restarts from 0 with the next ISR
+  TERN_(ENDSTOP_INPUT_CAPTURE, if (pulse_ticks < INT32_MAX / 2) pulse_ticks += next_isr_ticks);
+
   // Don't forget to finally reenable interrupts on non-AVR.
   // AVR automatically calls sei() for us on Return-from-Interrupt.
   #ifndef __AVR__
@@ -1624,7 +1671,7 @@ void Stepper::pulse_phase_isr() {
     abort_current_block = false;
     if (current_block) {
       discard_current_block();
-      #if HAS_ZV_SHAPING
+      #if HAS_SHAPING_ECHOES
         ShapingQueue::purge();
         #if ENABLED(INPUT_SHAPING_X)
           shaping_x.delta_error = 0;
@@ -1638,6 +1685,17 @@ void Stepper::pulse_phase_isr() {
     }
   }
 
+  #if ENABLED(BABYSTEP_SMOOTH)
+    // With no Z-idle move to go out with, do the waiting babystep on its own
+    if (babystep_z_fold && !(current_block && !current_block->steps.z && step_events_completed < step_event_count)) {
+      babystep_z_fold = 0;
+      DIR_WAIT_BEFORE();
+      SET_STEP_DIR(Z);
+      DIR_WAIT_AFTER();
+      nextBabystepISR = 0;
+    }
+  #endif
+
   // If there is no current block, do nothing
   if (!current_block || step_events_completed >= step_event_count) return;
 
@@ -1874,7 +1932,7 @@ void Stepper::pulse_phase_isr() {
         #endif
       #endif
 
-      #if HAS_ZV_SHAPING
+      #if HAS_SHAPING_ECHOES
         // record an echo if a step is needed in the primary bresenham
         const bool x_step = TERN0(INPUT_SHAPING_X, shaping_x.enabled && step_needed[X_AXIS]),
                    y_step = TERN0(INPUT_SHAPING_Y, shaping_y.enabled && step_needed[Y_AXIS]);
@@ -1910,6 +1968,9 @@ void Stepper::pulse_phase_isr() {
     #if HAS_Z_STEP
       PULSE_START(Z);
     #endif
+    #if ENABLED(BABYSTEP_SMOOTH)
+      if (babystep_z_fold) _APPLY_STEP(Z, !_INVERT_STEP_PIN(Z), 0);
+    #endif
     #if HAS_I_STEP
       PULSE_START(I);
     #endif
@@ -1956,6 +2017,15 @@ void Stepper::pulse_phase_isr() {
     #if HAS_Z_STEP
       PULSE_STOP(Z);
     #endif
+    #if ENABLED(BABYSTEP_SMOOTH)
+      if (babystep_z_fold) {
+        _APPLY_STEP(Z, _INVERT_STEP_PIN(Z), 0);
+        babystep.steps[BS_AXIS_IND(Z_AXIS)] -= babystep_z_fold;
+        babystep_z_fold = 0;
+        SET_STEP_DIR(Z);                                // Back to the block direction
+        nextBabystepISR = babystep.has_steps() ? BABYSTEP_TICKS : BABYSTEP_NEVER;
+      }
+    #endif
     #if HAS_I_STEP
       PULSE_STOP(I);
     #endif
@@ -1988,7 +2058,7 @@ void Stepper::pulse_phase_isr() {
   } while (--events_to_do);
 }
 
-#if HAS_ZV_SHAPING
+#if HAS_SHAPING_ECHOES
 
   void Stepper::shaping_isr() {
     xy_bool_t step_needed{0};
@@ -1998,18 +2068,19 @@ void Stepper::pulse_phase_isr() {
     TERN_(INPUT_SHAPING_Y, step_needed[Y_AXIS] = !ShapingQueue::peek_y() || ShapingQueue::free_count_y() < steps_per_isr);
 
     if (bool(step_needed)) while (true) {
+      // All echoes due together are summed into a single secondary bresenham update
       #if ENABLED(INPUT_SHAPING_X)
         if (step_needed[X_AXIS]) {
-          const bool forward = ShapingQueue::dequeue_x();
-          PULSE_PREP_SHAPING(X, shaping_x.delta_error, shaping_x.factor2 * (forward ? 1 : -1));
+          const int16_t dividend = ShapingQueue::dequeue_x(shaping_x.factor2, ShapingQueue::free_count_x() < steps_per_isr);
+          PULSE_PREP_SHAPING(X, shaping_x.delta_error, dividend);
           PULSE_START(X);
         }
       #endif
 
       #if ENABLED(INPUT_SHAPING_Y)
         if (step_needed[Y_AXIS]) {
-          const bool forward = ShapingQueue::dequeue_y();
-          PULSE_PREP_SHAPING(Y, shaping_y.delta_error, shaping_y.factor2 * (forward ? 1 : -1));
+          const int16_t dividend = ShapingQueue::dequeue_y(shaping_y.factor2, ShapingQueue::free_count_y() < steps_per_isr);
+          PULSE_PREP_SHAPING(Y, shaping_y.delta_error, dividend);
           PULSE_START(Y);
         }
       #endif
@@ -2040,7 +2111,7 @@ void Stepper::pulse_phase_isr() {
     }
   }
 
-#endif // HAS_ZV_SHAPING
+#endif // HAS_SHAPING_ECHOES
 
 // Calculate timer interval, with all limits applied.
 uint32_t Stepper::calc_timer_interval(uint32_t step_rate) {
@@ -2136,11 +2207,21 @@ uint32_t Stepper::block_phase_isr() {
         }
       #endif
       TERN_(HAS_FILAMENT_RUNOUT_DISTANCE, runout.block_completed(current_block));
+      TERN_(MOTION_TELEMETRY, motion_telemetry.isr_block_end());
       discard_current_block();
     }
     else {
       // Step events not completed yet...
 
+      #if ENABLED(SHAPING_TRAPEZOID)
+        // A shaped block follows its shaped speed profile from start to end
+        if (current_block->shaper) {
+          interval = calc_timer_interval(shaped_step_rate() << oversampling_factor, steps_per_isr);
+          acceleration_time += interval;
+        }
+        else
+      #endif
+
       // Are we in acceleration phase ?
       if (step_events_completed <= accelerate_until) { // Calculate new timer value
 
@@ -2162,8 +2243,12 @@ uint32_t Stepper::block_phase_isr() {
 
         #if ENABLED(LIN_ADVANCE)
           if (current_block->la_advance_rate) {
-            const uint32_t la_step_rate = la_advance_steps < current_block->max_adv_steps ? current_block->la_advance_rate : 0;
-            la_interval = calc_timer_interval(acc_step_rate + la_step_rate) << current_block->la_scaling;
+            #if ENABLED(SMOOTH_LIN_ADVANCE)
+              update_smooth_advance(acc_step_rate);
+            #else
+              const uint32_t la_step_rate = la_advance_steps < current_block->max_adv_steps ? current_block->la_advance_rate : 0;
+              la_interval = calc_timer_interval(acc_step_rate + la_step_rate) << current_block->la_scaling;
+            #endif
           }
         #endif
 
@@ -2232,37 +2317,18 @@ uint32_t Stepper::block_phase_isr() {
 
         #if ENABLED(LIN_ADVANCE)
           if (current_block->la_advance_rate) {
-            const uint32_t la_step_rate = la_advance_steps > current_block->final_adv_steps ? current_block->la_advance_rate : 0;
-            if (la_step_rate != step_rate) {
-              bool reverse_e = la_step_rate > step_rate;
-              la_interval = calc_timer_interval(reverse_e ? la_step_rate - step_rate : step_rate - la_step_rate) << current_block->la_scaling;
-
-              if (reverse_e != motor_direction(E_AXIS)) {
-                TBI(last_direction_bits, E_AXIS);
-                count_direction.e = -count_direction.e;
-
-                DIR_WAIT_BEFORE();
-
-                if (reverse_e) {
-                  #if ENABLED(MIXING_EXTRUDER)
-                    MIXER_STEPPER_LOOP(j) REV_E_DIR(j);
-                  #else
-                    REV_E_DIR(stepper_extruder);
-                  #endif
-                }
-                else {
-                  #if ENABLED(MIXING_EXTRUDER)
-                    MIXER_STEPPER_LOOP(j) NORM_E_DIR(j);
-                  #else
-                    NORM_E_DIR(stepper_extruder);
-                  #endif
-                }
-
-                DIR_WAIT_AFTER();
+            #if ENABLED(SMOOTH_LIN_ADVANCE)
+              update_smooth_advance(step_rate);
+            #else
+              const uint32_t la_step_rate = la_advance_steps > current_block->final_adv_steps ? current_block->la_advance_rate : 0;
+              if (la_step_rate != step_rate) {
+                const bool reverse_e = la_step_rate > step_rate;
+                la_interval = calc_timer_interval(reverse_e ? la_step_rate - step_rate : step_rate - la_step_rate) << current_block->la_scaling;
+                set_la_e_direction(reverse_e);
               }
-            }
-            else
-              la_interval = LA_ADV_NEVER;
+              else
+                la_interval = LA_ADV_NEVER;
+            #endif
           }
         #endif // LIN_ADVANCE
 
@@ -2292,15 +2358,27 @@ uint32_t Stepper::block_phase_isr() {
           ticks_nominal = calc_timer_interval(current_block->nominal_rate << oversampling_factor, steps_per_isr);
 
           #if ENABLED(LIN_ADVANCE)
-            if (current_block->la_advance_rate)
-              la_interval = calc_timer_interval(current_block->nominal_rate) << current_block->la_scaling;
+            if (current_block->la_advance_rate) {
+              #if ENABLED(SMOOTH_LIN_ADVANCE)
+                update_smooth_advance(current_block->nominal_rate);
+              #else
+                la_interval = calc_timer_interval(current_block->nominal_rate) << current_block->la_scaling;
+              #endif
+            }
           #endif
         }
+        #if ENABLED(SMOOTH_LIN_ADVANCE)
+          // Follow the advance ramps reaching into the cruise. The E rate is steady between them.
+          else if (current_block->la_advance_rate && !WITHIN(la_elapsed, current_block->la_accel_end + ticks_nominal, current_block->la_decel_start))
+            update_smooth_advance(current_block->nominal_rate);
+        #endif
 
         // The timer interval is just the nominal value for the nominal speed
         interval = ticks_nominal;
       }
 
+      TERN_(SMOOTH_LIN_ADVANCE, la_elapsed += interval);
+
       /**
        * Adjust Laser Power - Cruise
        * power - direct or floor adjusted active laser power.
@@ -2490,6 +2568,7 @@ uint32_t Stepper::block_phase_isr() {
 
       // No acceleration / deceleration time elapsed so far
       acceleration_time = deceleration_time = 0;
+      TERN_(SMOOTH_LIN_ADVANCE, la_elapsed = 0);
 
       #if ENABLED(ADAPTIVE_STEP_SMOOTHING)
         oversampling_factor = 0;                            // Assume no axis smoothing (via oversampling)
@@ -2512,7 +2591,8 @@ uint32_t Stepper::block_phase_isr() {
       advance_dividend = (current_block->steps << 1).asLong();
       advance_divisor = step_event_count << 1;
 
-      #if ENABLED(INPUT_SHAPING_X)
+      #if HAS_SHAPING_ECHO_X
+        if (shaping_x.next_echoes && ShapingQueue::empty_x()) apply_next_shaping(X_AXIS);
         if (shaping_x.enabled) {
           const int64_t steps = TEST(current_block->direction_bits, X_AXIS) ? -int64_t(current_block->steps.x) : int64_t(current_block->steps.x);
           shaping_x.last_block_end_pos += steps;
@@ -2526,7 +2606,8 @@ uint32_t Stepper::block_phase_isr() {
       #endif
 
       // Y follows the same logic as X (but the comments aren't repeated)
-      #if ENABLED(INPUT_SHAPING_Y)
+      #if HAS_SHAPING_ECHO_Y
+        if (shaping_y.next_echoes && ShapingQueue::empty_y()) apply_next_shaping(Y_AXIS);
         if (shaping_y.enabled) {
           const int64_t steps = TEST(current_block->direction_bits, Y_AXIS) ? -int64_t(current_block->steps.y) : int64_t(current_block->steps.y);
           shaping_y.last_block_end_pos += steps;
@@ -2614,11 +2695,22 @@ uint32_t Stepper::block_phase_isr() {
 
       #if ENABLED(LIN_ADVANCE)
         if (current_block->la_advance_rate) {
-          const uint32_t la_step_rate = la_advance_steps < current_block->max_adv_steps ? current_block->la_advance_rate : 0;
-          la_interval = calc_timer_interval(current_block->initial_rate + la_step_rate) << current_block->la_scaling;
+          #if ENABLED(SMOOTH_LIN_ADVANCE)
+            update_smooth_advance(current_block->initial_rate);
+            la_elapsed += interval;
+          #else
+            const uint32_t la_step_rate = la_advance_steps < current_block->max_adv_steps ? current_block->la_advance_rate : 0;
+            la_interval = calc_timer_interval(current_block->initial_rate + la_step_rate) << current_block->la_scaling;
+          #endif
         }
       #endif
+
+      TERN_(MOTION_TELEMETRY, motion_telemetry.isr_block_start(current_block));
     }
+    #if ENABLED(MOTION_TELEMETRY)
+      else
+        motion_telemetry.isr_starved();
+    #endif
   }
 
   // Return the interval to wait
@@ -2658,12 +2750,79 @@ uint32_t Stepper::block_phase_isr() {
     }
   }
 
+  // Run E backward to relieve pressure faster than the move extrudes, or forward again
+  void Stepper::set_la_e_direction(const bool reverse_e) {
+    if (reverse_e == motor_direction(E_AXIS)) return;
+
+    TBI(last_direction_bits, E_AXIS);
+    count_direction.e = -count_direction.e;
+
+    DIR_WAIT_BEFORE();
+
+    if (reverse_e) {
+      #if ENABLED(MIXING_EXTRUDER)
+        MIXER_STEPPER_LOOP(j) REV_E_DIR(j);
+      #else
+        REV_E_DIR(stepper_extruder);
+      #endif
+    }
+    else {
+      #if ENABLED(MIXING_EXTRUDER)
+        MIXER_STEPPER_LOOP(j) NORM_E_DIR(j);
+      #else
+        NORM_E_DIR(stepper_extruder);
+      #endif
+    }
+
+    DIR_WAIT_AFTER();
+  }
+
+  #if ENABLED(SMOOTH_LIN_ADVANCE)
+
+    /**
+     * Set the E rate for the lead axis 'step_rate' plus the smoothed advance rate.
+     * The advance rate is the planned acceleration averaged over la_smooth_ticks,
+     * ramping down from the accelerating advance as la_accel_end nears and into
+     * the decelerating advance after la_decel_start. Like the plain advance it
+     * stops at the cruise and exit pressures.
+     */
+    void Stepper::update_smooth_advance(const uint32_t step_rate) {
+      const uint32_t up = constrain(current_block->la_accel_end - la_elapsed, 0, la_smooth_ticks),
+                     down = constrain(la_elapsed - current_block->la_decel_start, 0, la_smooth_ticks);
+      int32_t e_rate = step_rate;
+      if (up && la_advance_steps < current_block->max_adv_steps)
+        e_rate += STEP_MULTIPLY(up, current_block->la_ramp_rate);
+      if (down && la_advance_steps > current_block->final_adv_steps)
+        e_rate -= STEP_MULTIPLY(down, current_block->la_ramp_rate);
+
+      if (e_rate) {
+        set_la_e_direction(e_rate < 0);
+        la_interval = calc_timer_interval(ABS(e_rate)) << current_block->la_scaling;
+      }
+      else
+        la_interval = LA_ADV_NEVER;
+    }
+
+  #endif
+
 #endif // LIN_ADVANCE
 
 #if ENABLED(INTEGRATED_BABYSTEPPING)
 
   // Timer interrupt for baby-stepping
   uint32_t Stepper::babystepping_isr() {
+    #if ENABLED(BABYSTEP_SMOOTH)
+      // During a move without Z, set the Z direction now and send the babystep with
+      // the next main pulse. The pulse phase schedules the following babystep.
+      const int16_t zsteps = babystep.steps[BS_AXIS_IND(Z_AXIS)];
+      if (zsteps && current_block && !current_block->steps.z) {
+        babystep_z_fold = zsteps > 0 ? 1 : -1;
+        enable_axis(Z_AXIS);
+        DIR_WAIT_BEFORE();
+        Z_APPLY_DIR(ENABLED(INVERT_Z_DIR) ^ (zsteps > 0) ^ BABYSTEP_INVERT_Z, false);
+        return BABYSTEP_NEVER;
+      }
+    #endif
     babystep.task();
     return babystep.has_steps() ? BABYSTEP_TICKS : BABYSTEP_NEVER;
   }
@@ -3019,32 +3178,208 @@ void Stepper::init() {
 #if HAS_ZV_SHAPING
 
   /**
-   * Calculate a fixed point factor to apply to the signal and its echo
-   * when shaping an axis.
+   * Calculate the fixed point factors and echo delays of the shaper for an axis
+   * from its type, frequency and damping ratio. Amplitudes follow the standard
+   * ZV, ZVD, MZV, EI and 2-hump EI definitions (vibration tolerance 5% for EI)
+   * and are normalized so the immediate step and its echoes add up to one step.
+   * Delays are multiples of the half period, the same as the original ZV shaper.
    */
-  void Stepper::set_shaping_damping_ratio(const AxisEnum axis, const_float_t zeta) {
-    // from the damping ratio, get a factor that can be applied to advance_dividend for fixed point maths
-    // for ZV, we use amplitudes 1/(1+K) and K/(1+K) where K = exp(-zeta * M_PI / sqrt(1.0f - zeta * zeta))
-    // which can be converted to 1:7 fixed point with an excellent fit with a 3rd order polynomial
-    float factor2;
-    if (zeta <= 0.0f) factor2 = 64.0f;
-    else if (zeta >= 1.0f) factor2 = 0.0f;
-    else {
-      factor2 = 64.44056192 + -99.02008832 * zeta;
-      const_float_t zeta2 = zeta * zeta;
-      factor2 += -7.58095488 * zeta2;
-      const_float_t zeta3 = zeta2 * zeta;
-      factor2 += 43.073216 * zeta3;
-      factor2 = floor(factor2);
+  void Stepper::update_shaping(const AxisEnum axis) {
+    ShapeParams &shaping = TERN(INPUT_SHAPING_X, TERN(INPUT_SHAPING_Y, axis == X_AXIS ? shaping_x : shaping_y, shaping_x), shaping_y);
+
+    const float zeta = shaping.zeta,
+                K = zeta <= 0.0f ? 1.0f : zeta >= 1.0f ? 0.0f : expf(-zeta * float(M_PI) / SQRT(1.0f - sq(zeta)));
+
+    float amp[shaping_echo_heads + 1], span[shaping_echo_heads];
+    uint8_t echoes = 1;
+    switch (shaping.type) {
+      default:
+      case SHAPER_ZV:
+        amp[0] = 1.0f; amp[1] = K; span[0] = 1.0f;
+        break;
+      #if ENABLED(SHAPING_MULTI_IMPULSE)
+        case SHAPER_ZVD:
+          amp[0] = 1.0f; amp[1] = 2.0f * K; amp[2] = sq(K);
+          span[0] = 1.0f; span[1] = 2.0f; echoes = 2;
+          break;
+        case SHAPER_MZV: {
+          const float Km = zeta <= 0.0f ? 1.0f : POW(K, 0.75f), a1 = 1.0f - float(M_SQRT1_2);
+          amp[0] = a1; amp[1] = float(M_SQRT2 - 1) * Km; amp[2] = a1 * sq(Km);
+          span[0] = 0.75f; span[1] = 1.5f; echoes = 2;
+        } break;
+        case SHAPER_EI: {
+          constexpr float vtol = 0.05f;
+          amp[0] = 0.25f * (1.0f + vtol); amp[1] = 0.5f * (1.0f - vtol) * K; amp[2] = amp[0] * sq(K);
+          span[0] = 1.0f; span[1] = 2.0f; echoes = 2;
+        } break;
+        case SHAPER_2HUMP_EI: {
+          constexpr float vtol2 = sq(0.05f);
+          const float X = POW(vtol2 * (SQRT(1.0f - vtol2) + 1.0f), 1.0f / 3.0f),
+                      a1 = (3.0f * sq(X) + 2.0f * X + 3.0f * vtol2) / (16.0f * X);
+          amp[0] = a1; amp[1] = (0.5f - a1) * K; amp[2] = amp[1] * K; amp[3] = a1 * K * sq(K);
+          span[0] = 1.0f; span[1] = 2.0f; span[2] = 3.0f; echoes = 3;
+        } break;
+      #endif
+    }
+
+    float total = amp[0];
+    for (uint8_t e = 1; e <= echoes; ++e) total += amp[e];
+
+    // Fixed point 1:7 echo factors, with the rounding left over on the immediate step
+    uint8_t factor2[shaping_echo_heads];
+    int16_t factor1 = 128;
+    for (uint8_t e = 0; e < echoes; ++e) {
+      factor2[e] = LROUND(amp[e + 1] * 128.0f / total);
+      factor1 -= factor2[e];
     }
 
+    const float half_period = shaping.frequency ? float(uint32_t(STEPPER_TIMER_RATE) / 2) / shaping.frequency : 0.0f;
+    #if ENABLED(SHAPING_TRAPEZOID)
+      uint32_t delays[shaping_echo_heads];
+      for (uint8_t e = 0; e < echoes; ++e) delays[e] = half_period * span[e];
+    #else
+      shaping_time_t delays[shaping_echo_heads];
+      for (uint8_t e = 0; e < echoes; ++e)
+        delays[e] = shaping.frequency ? shaping_time_t(half_period * span[e]) : shaping_time_t(-1);
+    #endif
+
     const bool was_on = hal.isr_state();
     hal.isr_off();
-    TERN_(INPUT_SHAPING_X, if (axis == X_AXIS) { shaping_x.factor2 = factor2; shaping_x.factor1 = 128 - factor2; shaping_x.zeta = zeta; })
-    TERN_(INPUT_SHAPING_Y, if (axis == Y_AXIS) { shaping_y.factor2 = factor2; shaping_y.factor1 = 128 - factor2; shaping_y.zeta = zeta; })
+    #if ENABLED(SHAPING_TRAPEZOID)
+      shaping.factor1 = factor1;
+      for (uint8_t e = 0; e < echoes; ++e) shaping.factor2[e] = factor2[e];
+      shaping.echoes = echoes;
+      for (uint8_t e = 0; e < echoes; ++e) shaping.delay[e] = delays[e];
+      update_trapezoid_shapers();
+    #else
+      shaping.next_factor1 = factor1;
+      for (uint8_t e = 0; e < echoes; ++e) {
+        shaping.next_factor2[e] = factor2[e];
+        shaping.next_delay[e] = delays[e];
+      }
+      shaping.next_echoes = echoes;
+      if (ShapingQueue::empty(axis))
+        apply_next_shaping(axis);
+      else if (echoes == ShapingQueue::echo_heads(axis) && shaping.frequency) {
+        // Same echo count, so the queued echoes can be timed by the new delays
+        shaping.next_echoes = 0;
+        shaping.factor1 = factor1;
+        for (uint8_t e = 0; e < echoes; ++e) shaping.factor2[e] = factor2[e];
+        ShapingQueue::update_delays(axis, delays);
+      }
+      // Otherwise the block phase applies the change once the queue is empty
+    #endif
     if (was_on) hal.isr_on();
   }
 
+  #if HAS_SHAPING_ECHOES
+
+    // Apply the factors and delays from update_shaping(). Changing the echo
+    // count rewinds the queue, so only call this with the queue empty.
+    void Stepper::apply_next_shaping(const AxisEnum axis) {
+      ShapeParams &shaping = TERN(INPUT_SHAPING_X, TERN(INPUT_SHAPING_Y, axis == X_AXIS ? shaping_x : shaping_y, shaping_x), shaping_y);
+      shaping.factor1 = shaping.next_factor1;
+      for (uint8_t e = 0; e < shaping.next_echoes; ++e) shaping.factor2[e] = shaping.next_factor2[e];
+      ShapingQueue::set_delays(axis, shaping.next_delay, shaping.next_echoes);
+      shaping.next_echoes = 0;
+    }
+
+  #endif
+
+  #if ENABLED(SHAPING_TRAPEZOID)
+
+    /**
+     * Rebuild the impulses applied to the trapezoid of blocks moving X only,
+     * Y only, or both. Both X and Y get the convolution of the two shapers
+     * (unless they are identical) so either resonance is cancelled whatever
+     * the direction of the block. Coincident impulses are merged.
+     */
+    void Stepper::update_trapezoid_shapers() {
+      trapezoid_shaper_t &tx = trapezoid_shapers[0], &ty = trapezoid_shapers[1], &txy = trapezoid_shapers[2];
+
+      auto load = [](trapezoid_shaper_t &ts, const ShapeParams &sp) {
+        ts.count = 0;
+        if (!sp.enabled) return;
+        ts.factor[0] = sp.factor1; ts.time[0] = 0;
+        for (uint8_t e = 0; e < sp.echoes; ++e) { ts.factor[e + 1] = sp.factor2[e]; ts.time[e + 1] = sp.delay[e]; }
+        ts.count = sp.echoes + 1;
+      };
+      auto finish = [](trapezoid_shaper_t &ts) {
+        uint32_t mean = 0;
+        for (uint8_t i = 0; i < ts.count; ++i) mean += (ts.factor[i] * ts.time[i]) >> 7;
+        ts.mean = mean;
+        ts.duration = ts.count ? ts.time[ts.count - 1] : 0;
+      };
+
+      tx.count = ty.count = 0;
+      TERN_(INPUT_SHAPING_X, load(tx, shaping_x));
+      TERN_(INPUT_SHAPING_Y, load(ty, shaping_y));
+      finish(tx); finish(ty);
+
+      #if ALL(INPUT_SHAPING_X, INPUT_SHAPING_Y)
+        const bool same = shaping_x.frequency == shaping_y.frequency && shaping_x.zeta == shaping_y.zeta && shaping_x.type == shaping_y.type;
+      #else
+        constexpr bool same = false;
+      #endif
+      if (same || !tx.count || !ty.count) { txy = tx.count ? tx : ty; return; }
+
+      // Convolve, keeping the impulses sorted by time
+      txy.count = 0;
+      int16_t total = 0;
+      for (uint8_t i = 0; i < tx.count; ++i) for (uint8_t j = 0; j < ty.count; ++j) {
+        const uint8_t f = (uint16_t(tx.factor[i]) * ty.factor[j] + 64) >> 7;
+        if (!f) continue;
+        const uint32_t t = tx.time[i] + ty.time[j];
+        uint8_t k = 0;
+        while (k < txy.count && txy.time[k] < t) k++;
+        if (k == txy.count || txy.time[k] != t) {
+          for (uint8_t m = txy.count; m > k; --m) { txy.time[m] = txy.time[m - 1]; txy.factor[m] = txy.factor[m - 1]; }
+          txy.time[k] = t; txy.factor[k] = 0;
+          txy.count++;
+        }
+        txy.factor[k] += f;
+        total += f;
+      }
+      // Leave the rounding on the first impulse so the factors add up to 128
+      txy.factor[0] += 128 - total;
+      finish(txy);
+    }
+
+    /**
+     * The step rate of the current block at acceleration_time. This is the speed of the
+     * block's reference trapezoid convolved with the shaper impulses, found by summing
+     * the clamped acceleration and deceleration times seen by each impulse.
+     */
+    uint32_t Stepper::shaped_step_rate() {
+      const trapezoid_shaper_t &shaper = trapezoid_shapers[current_block->shaper - 1];
+      const uint32_t t = acceleration_time,
+                     accel_ticks = current_block->shaped_accel_ticks,
+                     decel_start = current_block->shaped_decel_start_ticks,
+                     decel_ticks = current_block->shaped_decel_ticks;
+      uint64_t up = 0, down = 0;
+      for (uint8_t i = 0; i < shaper.count && t > shaper.time[i]; ++i) {
+        const uint32_t dt = t - shaper.time[i];
+        up += uint64_t(shaper.factor[i]) * _MIN(dt, accel_ticks);
+        if (dt > decel_start) down += uint64_t(shaper.factor[i]) * _MIN(dt - decel_start, decel_ticks);
+      }
+      const uint32_t rise = STEP_MULTIPLY(uint32_t(up >> 7), current_block->acceleration_rate),
+                     fall = STEP_MULTIPLY(uint32_t(down >> 7), current_block->acceleration_rate);
+      uint32_t step_rate = current_block->initial_rate + rise;
+      step_rate = step_rate > fall ? step_rate - fall : 0;
+      NOLESS(step_rate, _MIN(current_block->initial_rate, current_block->final_rate));
+      return step_rate;
+    }
+
+  #endif // SHAPING_TRAPEZOID
+
+  void Stepper::set_shaping_damping_ratio(const AxisEnum axis, const_float_t zeta) {
+    // Queued blocks have their shaped trapezoids timed for the current shaper
+    if (TERN0(SHAPING_TRAPEZOID, zeta != get_shaping_damping_ratio(axis))) planner.synchronize();
+    TERN_(INPUT_SHAPING_X, if (axis == X_AXIS) shaping_x.zeta = zeta);
+    TERN_(INPUT_SHAPING_Y, if (axis == Y_AXIS) shaping_y.zeta = zeta);
+    update_shaping(axis);
+  }
+
   float Stepper::get_shaping_damping_ratio(const AxisEnum axis) {
     TERN_(INPUT_SHAPING_X, if (axis == X_AXIS) return shaping_x.zeta);
     TERN_(INPUT_SHAPING_Y, if (axis == Y_AXIS) return shaping_y.zeta);
@@ -3058,10 +3393,8 @@ void Stepper::init() {
     const bool was_on = hal.isr_state();
     hal.isr_off();
 
-    const shaping_time_t delay = freq ? float(uint32_t(STEPPER_TIMER_RATE) / 2) / freq : shaping_time_t(-1);
     #if ENABLED(INPUT_SHAPING_X)
       if (axis == X_AXIS) {
-        ShapingQueue::set_delay(X_AXIS, delay);
         shaping_x.frequency = freq;
         shaping_x.enabled = !!freq;
         shaping_x.delta_error = 0;
@@ -3070,7 +3403,6 @@ void Stepper::init() {
     #endif
     #if ENABLED(INPUT_SHAPING_Y)
       if (axis == Y_AXIS) {
-        ShapingQueue::set_delay(Y_AXIS, delay);
         shaping_y.frequency = freq;
         shaping_y.enabled = !!freq;
         shaping_y.delta_error = 0;
@@ -3079,6 +3411,8 @@ void Stepper::init() {
     #endif
 
     if (was_on) hal.isr_on();
+
+    update_shaping(axis);
   }
 
   float Stepper::get_shaping_frequency(const AxisEnum axis) {
@@ -3087,6 +3421,22 @@ void Stepper::init() {
     return -1;
   }
 
+  void Stepper::set_shaping_type(const AxisEnum axis, const ShapingType type) {
+    // Settings load sets the type on every call, so don't stall a print for no change
+    if (type == get_shaping_type(axis)) return;
+    // the echo count can only change with the queue empty
+    planner.synchronize();
+    TERN_(INPUT_SHAPING_X, if (axis == X_AXIS) shaping_x.type = type);
+    TERN_(INPUT_SHAPING_Y, if (axis == Y_AXIS) shaping_y.type = type);
+    update_shaping(axis);
+  }
+
+  ShapingType Stepper::get_shaping_type(const AxisEnum axis) {
+    TERN_(INPUT_SHAPING_X, if (axis == X_AXIS) return shaping_x.type);
+    TERN_(INPUT_SHAPING_Y, if (axis == Y_AXIS) return shaping_y.type);
+    return SHAPER_ZV;
+  }
+
 #endif // HAS_ZV_SHAPING
 
 /**
@@ -3099,10 +3449,10 @@ void Stepper::init() {
  * derive the current XYZE position later on.
  */
 void Stepper::_set_position(const abce_long_t &spos) {
-  #if ENABLED(INPUT_SHAPING_X)
+  #if HAS_SHAPING_ECHO_X
     const int32_t x_shaping_delta = count_position.x - shaping_x.last_block_end_pos;
   #endif
-  #if ENABLED(INPUT_SHAPING_Y)
+  #if HAS_SHAPING_ECHO_Y
     const int32_t y_shaping_delta = count_position.y - shaping_y.last_block_end_pos;
   #endif
 
@@ -3136,13 +3486,13 @@ void Stepper::_set_position(const abce_long_t &spos) {
     count_position = spos;
   #endif
 
-  #if ENABLED(INPUT_SHAPING_X)
+  #if HAS_SHAPING_ECHO_X
     if (shaping_x.enabled) {
       count_position.x += x_shaping_delta;
       shaping_x.last_block_end_pos = spos.x;
     }
   #endif
-  #if ENABLED(INPUT_SHAPING_Y)
+  #if HAS_SHAPING_ECHO_Y
     if (shaping_y.enabled) {
       count_position.y += y_shaping_delta;
       shaping_y.last_block_end_pos = spos.y;
@@ -3187,8 +3537,8 @@ void Stepper::set_axis_position(const AxisEnum a, const int32_t &v) {
   #endif
 
   count_position[a] = v;
-  TERN_(INPUT_SHAPING_X, if (a == X_AXIS) shaping_x.last_block_end_pos = v);
-  TERN_(INPUT_SHAPING_Y, if (a == Y_AXIS) shaping_y.last_block_end_pos = v);
+  TERN_(HAS_SHAPING_ECHO_X, if (a == X_AXIS) shaping_x.last_block_end_pos = v);
+  TERN_(HAS_SHAPING_ECHO_Y, if (a == Y_AXIS) shaping_y.last_block_end_pos = v);
 
   #ifdef __AVR__
     // Reenable Stepper ISR
@@ -3205,24 +3555,34 @@ void Stepper::set_axis_position(const AxisEnum a, const int32_t &v) {
 void Stepper::endstop_triggered(const AxisEnum axis) {
 
   const bool was_enabled = suspend();
-  endstops_trigsteps[axis] = (
-    #if IS_CORE
-      (axis == CORE_AXIS_2
-        ? CORESIGN(count_position[CORE_AXIS_1] - count_position[CORE_AXIS_2])
-        : count_position[CORE_AXIS_1] + count_position[CORE_AXIS_2]
-      ) * double(0.5)
-    #elif ENABLED(MARKFORGED_XY)
-      axis == CORE_AXIS_1
-        ? count_position[CORE_AXIS_1] - count_position[CORE_AXIS_2]
-        : count_position[CORE_AXIS_2]
-    #elif ENABLED(MARKFORGED_YX)
-      axis == CORE_AXIS_1
-        ? count_position[CORE_AXIS_1]
-        : count_position[CORE_AXIS_2] - count_position[CORE_AXIS_1]
-    #else // !IS_CORE
-      count_position[axis]
-    #endif
-  );
+
+  #if IS_CORE
+    #define _TRIGGERED_POS(P) ((axis == CORE_AXIS_2 ? CORESIGN(P[CORE_AXIS_1] - P[CORE_AXIS_2]) : P[CORE_AXIS_1] + P[CORE_AXIS_2]) * double(0.5))
+  #elif ENABLED(MARKFORGED_XY)
+    #define _TRIGGERED_POS(P) (axis == CORE_AXIS_1 ? P[CORE_AXIS_1] - P[CORE_AXIS_2] : P[CORE_AXIS_2])
+  #elif ENABLED(MARKFORGED_YX)
+    #define _TRIGGERED_POS(P) (axis == CORE_AXIS_1 ? P[CORE_AXIS_1] : P[CORE_AXIS_2] - P[CORE_AXIS_1])
+  #else // !IS_CORE
+    #define _TRIGGERED_POS(P) P[axis]
+  #endif
+
+  endstops_trigsteps[axis] = _TRIGGERED_POS(count_position);
+
+  #if ENABLED(ENDSTOP_INPUT_CAPTURE)
+    /**
+     * The edge came some time after the last pulse. Each motor was on its
+     * way to its next step, so at the current block rate it had covered
+     * this part of the pulse interval times its share of the step events.
+     */
+    xyz_float_t sub{0};
+    if (edge_captured && current_block && pulse_interval && step_event_count) {
+      const float part = _MIN(1.0f, float(_MAX(edge_ticks, int32_t(0))) / pulse_interval) * steps_per_isr / step_event_count;
+      LOOP_NUM_AXES(i) if (TEST(axis_did_move, i)) sub[i] = part * current_block->steps[i] * count_direction[i];
+    }
+    endstops_trigsub[axis] = _TRIGGERED_POS(sub);
+  #endif
+
+  #undef _TRIGGERED_POS
 
   // Discard the rest of the move if there is a current block
   quick_stop();
@@ -3230,6 +3590,20 @@ void Stepper::endstop_triggered(const AxisEnum axis) {
   if (was_enabled) wake_up();
 }
 
+#if ENABLED(ENDSTOP_INPUT_CAPTURE)
+
+  // Called from the endstop pin interrupt. The step timer count is the
+  // time since the last Stepper ISR, which gives the time since the last
+  // main pulse. Only updates started here get the sub-step position.
+  void Stepper::capture_endstop_edge(const hal_timer_t count) {
+    edge_ticks = pulse_ticks + int32_t(count);
+    edge_captured = true;
+    endstops.update();
+    edge_captured = false;
+  }
+
+#endif
+
 int32_t Stepper::triggered_position(const AxisEnum axis) {
   #ifdef __AVR__
     // Protect the access to the position. Only required for AVR, as
@@ -97,8 +97,10 @@
   #endif
 
   // Input shaping base time
-  #if HAS_ZV_SHAPING
+  #if HAS_SHAPING_ECHOES
     #define ISR_SHAPING_BASE_CYCLES 180UL
+  #elif ENABLED(SHAPING_TRAPEZOID)
+    #define ISR_SHAPING_BASE_CYCLES (12UL * sq(TERN(SHAPING_MULTI_IMPULSE, 4, 2)))
   #else
     #define ISR_SHAPING_BASE_CYCLES 0UL
   #endif
@@ -131,8 +133,10 @@
   #endif
 
   // Input shaping base time
-  #if HAS_ZV_SHAPING
+  #if HAS_SHAPING_ECHOES
     #define ISR_SHAPING_BASE_CYCLES 290UL
+  #elif ENABLED(SHAPING_TRAPEZOID)
+    #define ISR_SHAPING_BASE_CYCLES (60UL * sq(TERN(SHAPING_MULTI_IMPULSE, 4, 2)))
   #else
     #define ISR_SHAPING_BASE_CYCLES 0UL
   #endif
@@ -220,7 +224,7 @@
 #define ISR_LOOP_CYCLES(R) ((ISR_LOOP_BASE_CYCLES + MIN_ISR_LOOP_CYCLES + MIN_STEPPER_PULSE_CYCLES) * (R - 1) + _MAX(MIN_ISR_LOOP_CYCLES, MIN_STEPPER_PULSE_CYCLES))
 
 // Model input shaping as an extra loop call
-#define ISR_SHAPING_LOOP_CYCLES(R) TERN0(HAS_ZV_SHAPING, (R) * ((ISR_LOOP_BASE_CYCLES) + TERN0(INPUT_SHAPING_X, ISR_X_STEPPER_CYCLES) + TERN0(INPUT_SHAPING_Y, ISR_Y_STEPPER_CYCLES)))
+#define ISR_SHAPING_LOOP_CYCLES(R) TERN0(HAS_SHAPING_ECHOES, (R) * ((ISR_LOOP_BASE_CYCLES) + TERN0(INPUT_SHAPING_X, ISR_X_STEPPER_CYCLES) + TERN0(INPUT_SHAPING_Y, ISR_Y_STEPPER_CYCLES)))
 
 // If linear advance is enabled, then it is handled separately
 #if ENABLED(LIN_ADVANCE)
@@ -344,6 +348,19 @@ constexpr ena_mask_t enable_overlap[] = {
 
 #if HAS_ZV_SHAPING
 
+  // Shaper types selectable with M593 T. Each adds 1-3 delayed echoes to the primary step.
+  enum ShapingType : uint8_t { SHAPER_ZV, SHAPER_ZVD, SHAPER_MZV, SHAPER_EI, SHAPER_2HUMP_EI, SHAPER_COUNT };
+
+  // Echo heads per axis and the longest echo delay, in half periods of the shaping frequency
+  constexpr uint8_t shaping_echo_heads = TERN(SHAPING_MULTI_IMPULSE, 3, 1),
+                    shaping_max_span = TERN(SHAPING_MULTI_IMPULSE, 3, 1);
+
+  typedef IF<ENABLED(__AVR__), uint16_t, uint32_t>::type shaping_time_t;
+
+#endif
+
+#if HAS_SHAPING_ECHOES
+
   #ifdef SHAPING_MAX_STEPRATE
     constexpr float max_step_rate = SHAPING_MAX_STEPRATE;
   #else
@@ -368,16 +385,21 @@ constexpr ena_mask_t enable_overlap[] = {
   #ifndef SHAPING_MIN_FREQ
     #define SHAPING_MIN_FREQ _MIN(0x7FFFFFFFL OPTARG(INPUT_SHAPING_X, SHAPING_FREQ_X) OPTARG(INPUT_SHAPING_Y, SHAPING_FREQ_Y))
   #endif
+
   constexpr uint16_t shaping_min_freq = SHAPING_MIN_FREQ,
-                     shaping_echoes = max_step_rate / shaping_min_freq / 2 + 3;
+                     shaping_echoes = max_step_rate / shaping_min_freq / 2 * shaping_max_span + 3;
 
-  typedef IF<ENABLED(__AVR__), uint16_t, uint32_t>::type shaping_time_t;
   enum shaping_echo_t { ECHO_NONE = 0, ECHO_FWD = 1, ECHO_BWD = 2 };
   struct shaping_echo_axis_t {
     TERN_(INPUT_SHAPING_X, shaping_echo_t x:2);
     TERN_(INPUT_SHAPING_Y, shaping_echo_t y:2);
   };
 
+  /**
+   * Each recorded step is replayed once per echo of the active shaper. Every echo has its
+   * own read head into the shared queue, with the longest delay lagging furthest behind,
+   * so the queue size (and SRAM) depends only on the longest delay, not on the shaper order.
+   */
   class ShapingQueue {
     private:
       static shaping_time_t       now;
@@ -386,87 +408,215 @@ constexpr ena_mask_t enable_overlap[] = {
       static uint16_t             tail;
 
       #if ENABLED(INPUT_SHAPING_X)
-        static shaping_time_t delay_x;    // = shaping_time_t(-1) to disable queueing
-        static shaping_time_t peek_x_val;
-        static uint16_t head_x;
+        static shaping_time_t delay_x[shaping_echo_heads];    // = shaping_time_t(-1) to disable queueing
+        static shaping_time_t peek_x_val[shaping_echo_heads];
+        static uint16_t head_x[shaping_echo_heads];
         static uint16_t _free_count_x;
+        static uint8_t heads_x;                               // Echo heads in use by the X shaper
       #endif
       #if ENABLED(INPUT_SHAPING_Y)
-        static shaping_time_t delay_y;    // = shaping_time_t(-1) to disable queueing
-        static shaping_time_t peek_y_val;
-        static uint16_t head_y;
+        static shaping_time_t delay_y[shaping_echo_heads];    // = shaping_time_t(-1) to disable queueing
+        static shaping_time_t peek_y_val[shaping_echo_heads];
+        static uint16_t head_y[shaping_echo_heads];
         static uint16_t _free_count_y;
+        static uint8_t heads_y;                               // Echo heads in use by the Y shaper
+      #endif
+
+      #if ENABLED(INPUT_SHAPING_X)
+        static void advance_x(const uint8_t e) {
+          do {
+            if (e == heads_x - 1) _free_count_x++;
+            if (++head_x[e] == shaping_echoes) head_x[e] = 0;
+          } while (head_x[e] != tail && echo_axes[head_x[e]].x == ECHO_NONE);
+          peek_x_val[e] = head_x[e] == tail ? shaping_time_t(-1) : times[head_x[e]] + delay_x[e] - now;
+        }
+      #endif
+      #if ENABLED(INPUT_SHAPING_Y)
+        static void advance_y(const uint8_t e) {
+          do {
+            if (e == heads_y - 1) _free_count_y++;
+            if (++head_y[e] == shaping_echoes) head_y[e] = 0;
+          } while (head_y[e] != tail && echo_axes[head_y[e]].y == ECHO_NONE);
+          peek_y_val[e] = head_y[e] == tail ? shaping_time_t(-1) : times[head_y[e]] + delay_y[e] - now;
+        }
       #endif
 
     public:
       static void decrement_delays(const shaping_time_t interval) {
         now += interval;
-        TERN_(INPUT_SHAPING_X, if (peek_x_val != shaping_time_t(-1)) peek_x_val -= interval);
-        TERN_(INPUT_SHAPING_Y, if (peek_y_val != shaping_time_t(-1)) peek_y_val -= interval);
+        #if ENABLED(INPUT_SHAPING_X)
+          for (uint8_t e = 0; e < heads_x; ++e) if (peek_x_val[e] != shaping_time_t(-1)) peek_x_val[e] -= interval;
+        #endif
+        #if ENABLED(INPUT_SHAPING_Y)
+          for (uint8_t e = 0; e < heads_y; ++e) if (peek_y_val[e] != shaping_time_t(-1)) peek_y_val[e] -= interval;
+        #endif
+      }
+      // Set the echo delays for an axis. Only call this with the queue empty.
+      static void set_delays(const AxisEnum axis, const shaping_time_t delays[], const uint8_t count) {
+        #if ENABLED(INPUT_SHAPING_X)
+          if (axis == X_AXIS) {
+            heads_x = count;
+            for (uint8_t e = 0; e < shaping_echo_heads; ++e) {
+              delay_x[e] = e < count ? delays[e] : shaping_time_t(-1);
+              head_x[e] = tail; peek_x_val[e] = shaping_time_t(-1);
+            }
+            _free_count_x = shaping_echoes - 1;
+          }
+        #endif
+        #if ENABLED(INPUT_SHAPING_Y)
+          if (axis == Y_AXIS) {
+            heads_y = count;
+            for (uint8_t e = 0; e < shaping_echo_heads; ++e) {
+              delay_y[e] = e < count ? delays[e] : shaping_time_t(-1);
+              head_y[e] = tail; peek_y_val[e] = shaping_time_t(-1);
+            }
+            _free_count_y = shaping_echoes - 1;
+          }
+        #endif
       }
-      static void set_delay(const AxisEnum axis, const shaping_time_t delay) {
-        TERN_(INPUT_SHAPING_X, if (axis == X_AXIS) delay_x = delay);
-        TERN_(INPUT_SHAPING_Y, if (axis == Y_AXIS) delay_y = delay);
+      // Change the echo delays for an axis, keeping the count. Queued echoes fall due by the new delays.
+      static void update_delays(const AxisEnum axis, const shaping_time_t delays[]) {
+        auto due = [](const shaping_time_t delay, const uint16_t head) {
+          if (head == tail) return shaping_time_t(-1);
+          const shaping_time_t age = now - times[head];
+          return delay > age ? shaping_time_t(delay - age) : shaping_time_t(0);
+        };
+        #if ENABLED(INPUT_SHAPING_X)
+          if (axis == X_AXIS) for (uint8_t e = 0; e < heads_x; ++e) {
+            delay_x[e] = delays[e];
+            peek_x_val[e] = due(delays[e], head_x[e]);
+          }
+        #endif
+        #if ENABLED(INPUT_SHAPING_Y)
+          if (axis == Y_AXIS) for (uint8_t e = 0; e < heads_y; ++e) {
+            delay_y[e] = delays[e];
+            peek_y_val[e] = due(delays[e], head_y[e]);
+          }
+        #endif
+      }
+      static uint8_t echo_heads(const AxisEnum axis) {
+        TERN_(INPUT_SHAPING_X, if (axis == X_AXIS) return heads_x);
+        TERN_(INPUT_SHAPING_Y, if (axis == Y_AXIS) return heads_y);
+        return 0;
+      }
+      static bool empty(const AxisEnum axis) {
+        TERN_(INPUT_SHAPING_X, if (axis == X_AXIS) return empty_x());
+        TERN_(INPUT_SHAPING_Y, if (axis == Y_AXIS) return empty_y());
+        return true;
       }
       static void enqueue(const bool x_step, const bool x_forward, const bool y_step, const bool y_forward) {
-        TERN_(INPUT_SHAPING_X, if (head_x == tail && x_step) peek_x_val = delay_x);
-        TERN_(INPUT_SHAPING_Y, if (head_y == tail && y_step) peek_y_val = delay_y);
+        #if ENABLED(INPUT_SHAPING_X)
+          if (x_step) for (uint8_t e = 0; e < heads_x; ++e) if (head_x[e] == tail) peek_x_val[e] = delay_x[e];
+        #endif
+        #if ENABLED(INPUT_SHAPING_Y)
+          if (y_step) for (uint8_t e = 0; e < heads_y; ++e) if (head_y[e] == tail) peek_y_val[e] = delay_y[e];
+        #endif
         times[tail] = now;
         TERN_(INPUT_SHAPING_X, echo_axes[tail].x = x_step ? (x_forward ? ECHO_FWD : ECHO_BWD) : ECHO_NONE);
         TERN_(INPUT_SHAPING_Y, echo_axes[tail].y = y_step ? (y_forward ? ECHO_FWD : ECHO_BWD) : ECHO_NONE);
         if (++tail == shaping_echoes) tail = 0;
         TERN_(INPUT_SHAPING_X, _free_count_x--);
         TERN_(INPUT_SHAPING_Y, _free_count_y--);
-        TERN_(INPUT_SHAPING_X, if (echo_axes[head_x].x == ECHO_NONE) dequeue_x());
-        TERN_(INPUT_SHAPING_Y, if (echo_axes[head_y].y == ECHO_NONE) dequeue_y());
+        #if ENABLED(INPUT_SHAPING_X)
+          for (uint8_t e = 0; e < heads_x; ++e) if (echo_axes[head_x[e]].x == ECHO_NONE) advance_x(e);
+        #endif
+        #if ENABLED(INPUT_SHAPING_Y)
+          for (uint8_t e = 0; e < heads_y; ++e) if (echo_axes[head_y[e]].y == ECHO_NONE) advance_y(e);
+        #endif
       }
       #if ENABLED(INPUT_SHAPING_X)
-        static shaping_time_t peek_x() { return peek_x_val; }
-        static bool dequeue_x() {
-          bool forward = echo_axes[head_x].x == ECHO_FWD;
-          do {
-            _free_count_x++;
-            if (++head_x == shaping_echoes) head_x = 0;
-          } while (head_x != tail && echo_axes[head_x].x == ECHO_NONE);
-          peek_x_val = head_x == tail ? shaping_time_t(-1) : times[head_x] + delay_x - now;
-          return forward;
+        static shaping_time_t peek_x() {
+          shaping_time_t t = peek_x_val[0];
+          for (uint8_t e = 1; e < heads_x; ++e) NOMORE(t, peek_x_val[e]);
+          return t;
+        }
+        // Consume the due echoes, plus the oldest ones when 'flush' is set, and
+        // return their signed share of a step in 1:7 fixed point.
+        static int16_t dequeue_x(const uint8_t factor[], const bool flush) {
+          int16_t dividend = 0;
+          const uint16_t oldest = head_x[heads_x - 1];
+          for (uint8_t e = 0; e < heads_x; ++e) {
+            if (peek_x_val[e] && !(flush && head_x[e] == oldest)) continue;
+            dividend += echo_axes[head_x[e]].x == ECHO_FWD ? factor[e] : -int16_t(factor[e]);
+            advance_x(e);
+          }
+          return dividend;
         }
-        static bool empty_x() { return head_x == tail; }
+        static bool empty_x() { return head_x[heads_x - 1] == tail; }
         static uint16_t free_count_x() { return _free_count_x; }
       #endif
       #if ENABLED(INPUT_SHAPING_Y)
-        static shaping_time_t peek_y() { return peek_y_val; }
-        static bool dequeue_y() {
-          bool forward = echo_axes[head_y].y == ECHO_FWD;
-          do {
-            _free_count_y++;
-            if (++head_y == shaping_echoes) head_y = 0;
-          } while (head_y != tail && echo_axes[head_y].y == ECHO_NONE);
-          peek_y_val = head_y == tail ? shaping_time_t(-1) : times[head_y] + delay_y - now;
-          return forward;
+        static shaping_time_t peek_y() {
+          shaping_time_t t = peek_y_val[0];
+          for (uint8_t e = 1; e < heads_y; ++e) NOMORE(t, peek_y_val[e]);
+          return t;
+        }
+        static int16_t dequeue_y(const uint8_t factor[], const bool flush) {
+          int16_t dividend = 0;
+          const uint16_t oldest = head_y[heads_y - 1];
+          for (uint8_t e = 0; e < heads_y; ++e) {
+            if (peek_y_val[e] && !(flush && head_y[e] == oldest)) continue;
+            dividend += echo_axes[head_y[e]].y == ECHO_FWD ? factor[e] : -int16_t(factor[e]);
+            advance_y(e);
+          }
+          return dividend;
         }
-        static bool empty_y() { return head_y == tail; }
+        static bool empty_y() { return head_y[heads_y - 1] == tail; }
         static uint16_t free_count_y() { return _free_count_y; }
       #endif
       static void purge() {
         const auto st = shaping_time_t(-1);
         #if ENABLED(INPUT_SHAPING_X)
-          head_x = tail; _free_count_x = shaping_echoes - 1; peek_x_val = st;
+          for (uint8_t e = 0; e < shaping_echo_heads; ++e) { head_x[e] = tail; peek_x_val[e] = st; }
+          _free_count_x = shaping_echoes - 1;
         #endif
         #if ENABLED(INPUT_SHAPING_Y)
-          head_y = tail; _free_count_y = shaping_echoes - 1; peek_y_val = st;
+          for (uint8_t e = 0; e < shaping_echo_heads; ++e) { head_y[e] = tail; peek_y_val[e] = st; }
+          _free_count_y = shaping_echoes - 1;
         #endif
       }
   };
 
+#endif // HAS_SHAPING_ECHOES
+
+#if ENABLED(SHAPING_TRAPEZOID)
+
+  /**
+   * Impulses convolved with the speed trapezoid of a block. Times are in
+   * stepper timer ticks, ascending from 0, and the 1:7 fixed point factors
+   * add up to 128. Blocks moving X and Y get both shapers convolved.
+   */
+  constexpr uint8_t trapezoid_max_impulses = sq(shaping_echo_heads + 1);
+  struct trapezoid_shaper_t {
+    uint8_t count;
+    uint8_t factor[trapezoid_max_impulses];
+    uint32_t time[trapezoid_max_impulses];
+    uint32_t duration,                      // Time of the last impulse
+             mean;                          // Amplitude-weighted mean impulse time (the lag of the shaped motion)
+  };
+
+#endif
+
+#if HAS_ZV_SHAPING
+
   struct ShapeParams {
     float frequency;
     float zeta;
+    ShapingType type;
     bool enabled : 1;
     bool forward : 1;
     int16_t delta_error = 0;    // delta_error for seconday bresenham mod 128
-    uint8_t factor1;
-    uint8_t factor2;
+    uint8_t factor1;                        // Share of the step applied immediately
+    uint8_t factor2[shaping_echo_heads];    // Share of the step applied by each echo
+    #if ENABLED(SHAPING_TRAPEZOID)
+      uint8_t echoes;                       // Echoes used by the shaper type
+      uint32_t delay[shaping_echo_heads];   // Echo delays in stepper timer ticks
+    #else
+      // A change of the echo count, waiting for the queue to empty
+      uint8_t next_echoes = 0;
+      uint8_t next_factor1, next_factor2[shaping_echo_heads];
+      shaping_time_t next_delay[shaping_echo_heads];
+    #endif
     int32_t last_block_end_pos = 0;
   };
 
@@ -581,6 +731,9 @@ class Stepper {
       #if ENABLED(INPUT_SHAPING_Y)
         static ShapeParams shaping_y;
       #endif
+      #if ENABLED(SHAPING_TRAPEZOID)
+        static trapezoid_shaper_t trapezoid_shapers[3];   // For blocks moving X, Y, or both
+      #endif
     #endif
 
     #if ENABLED(LIN_ADVANCE)
@@ -590,11 +743,17 @@ class Stepper {
       static int32_t  la_delta_error,   // Analogue of delta_error.e for E steps in LA ISR
                       la_dividend,      // Analogue of advance_dividend.e for E steps in LA ISR
                       la_advance_steps; // Count of steps added to increase nozzle pressure
+      #if ENABLED(SMOOTH_LIN_ADVANCE)
+        static int32_t la_elapsed;      // Ticks since the start of the block
+      #endif
     #endif
 
     #if ENABLED(INTEGRATED_BABYSTEPPING)
       static constexpr uint32_t BABYSTEP_NEVER = 0xFFFFFFFF;
       static uint32_t nextBabystepISR;
+      #if ENABLED(BABYSTEP_SMOOTH)
+        static int8_t babystep_z_fold;  // Direction (+1/-1) of a Z babystep waiting for the next main pulse
+      #endif
     #endif
 
     #if ENABLED(DIRECT_STEPPING)
@@ -609,6 +768,14 @@ class Stepper {
     // Exact steps at which an endstop was triggered
     static xyz_long_t endstops_trigsteps;
 
+    #if ENABLED(ENDSTOP_INPUT_CAPTURE)
+      static xyz_float_t endstops_trigsub;  // Fraction of a step moved past endstops_trigsteps at the trigger
+      static int32_t pulse_ticks;           // Step timer ticks from the last main pulse to the start of this ISR (negative within it)
+      static uint32_t pulse_interval;       // Step timer ticks between main pulses
+      static int32_t edge_ticks;            // Step timer ticks from the last main pulse to the captured edge
+      static bool edge_captured;            // The endstop update in progress was started by a captured edge
+    #endif
+
     // Positions of stepper motors, in step units
     static xyze_long_t count_position;
 
@@ -642,13 +809,25 @@ class Stepper {
     // The stepper block processing ISR phase
     static uint32_t block_phase_isr();
 
-    #if HAS_ZV_SHAPING
+    #if HAS_SHAPING_ECHOES
       static void shaping_isr();
+      static void apply_next_shaping(const AxisEnum axis);
+    #endif
+    #if HAS_ZV_SHAPING
+      static void update_shaping(const AxisEnum axis);
+    #endif
+    #if ENABLED(SHAPING_TRAPEZOID)
+      static void update_trapezoid_shapers();
+      static uint32_t shaped_step_rate();
     #endif
 
     #if ENABLED(LIN_ADVANCE)
       // The Linear advance ISR phase
       static void advance_isr();
+      static void set_la_e_direction(const bool reverse_e);
+      #if ENABLED(SMOOTH_LIN_ADVANCE)
+        static void update_smooth_advance(const uint32_t step_rate);
+      #endif
     #endif
 
     #if ENABLED(INTEGRATED_BABYSTEPPING)
@@ -665,7 +844,7 @@ class Stepper {
     // Check if the given block is busy or not - Must not be called from ISR contexts
     static bool is_block_busy(const block_t * const block);
 
-    #if HAS_ZV_SHAPING
+    #if HAS_SHAPING_ECHOES
       // Check whether the stepper is processing any input shaping echoes
       static bool input_shaping_busy() {
         const bool was_on = hal.isr_state();
@@ -716,6 +895,14 @@ class Stepper {
     // Triggered position of an axis in steps
     static int32_t triggered_position(const AxisEnum axis);
 
+    #if ENABLED(ENDSTOP_INPUT_CAPTURE)
+      // Timestamp an endstop edge with the step timer count and update the endstops
+      static void capture_endstop_edge(const hal_timer_t count);
+
+      // Distance moved past the triggered position at the edge, in (signed) steps
+      static float triggered_substep(const AxisEnum axis) { return endstops_trigsub[axis]; }
+    #endif
+
     #if HAS_MOTOR_CURRENT_SPI || HAS_MOTOR_CURRENT_PWM
       static void set_digipot_value_spi(const int16_t address, const int16_t value);
       static void set_digipot_current(const uint8_t driver, const int16_t current);
@@ -818,6 +1005,12 @@ class Stepper {
       static float get_shaping_damping_ratio(const AxisEnum axis);
       static void set_shaping_frequency(const AxisEnum axis, const_float_t freq);
       static float get_shaping_frequency(const AxisEnum axis);
+      static void set_shaping_type(const AxisEnum axis, const ShapingType type);
+      static ShapingType get_shaping_type(const AxisEnum axis);
+    #endif
+    #if ENABLED(SHAPING_TRAPEZOID)
+      // The shaper for a block moving X (1), Y (2) or both (3)
+      static const trapezoid_shaper_t& trapezoid_shaper(const uint8_t axes) { return trapezoid_shapers[axes - 1]; }
     #endif
 
   private:
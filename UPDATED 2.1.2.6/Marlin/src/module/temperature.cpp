@@ -72,6 +72,10 @@
   #include "../feature/spindle_laser.h"
 #endif
 
+#if ENABLED(CPU_PROFILER)
+  #include "../feature/cpu_profiler.h"
+#endif
+
 // MAX TC related macros
 #define TEMP_SENSOR_IS_MAX(n, M) (ENABLED(TEMP_SENSOR_##n##_IS_MAX##M) || (ENABLED(TEMP_SENSOR_REDUNDANT_IS_MAX##M) && REDUNDANT_TEMP_MATCH(SOURCE, E##n)))
 
@@ -3518,6 +3522,7 @@ public:
  *  - Planner clean buffer
  */
 void Temperature::isr() {
+  TERN_(CPU_PROFILER, PROFILE_SCOPE(TEMP_ISR));
 
   // Shut down the laser if steppers are inactive for > LASER_SAFETY_TIMEOUT_MS ms
   #if LASER_SAFETY_TIMEOUT_MS > 0
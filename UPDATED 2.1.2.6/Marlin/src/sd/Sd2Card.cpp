@@ -121,6 +121,10 @@
 // Send command and return error code. Return zero for OK
 uint8_t DiskIODriver_SPI_SD::cardCommand(const uint8_t cmd, const uint32_t arg) {
 
+  #if ENABLED(SD_STREAM_READS)
+    if (cmd != CMD12) streamStop(); // Any other command ends an open multi-block read
+  #endif
+
   #if ENABLED(SDCARD_COMMANDS_SPLIT)
     if (cmd != CMD12) chipDeselect();
   #endif
@@ -286,6 +290,7 @@ bool DiskIODriver_SPI_SD::init(const uint8_t sckRateID, const pin_t chipSelectPi
 
   errorCode_ = type_ = 0;
   chipSelectPin_ = chipSelectPin;
+  TERN_(SD_STREAM_READS, streaming_ = false; lastBlock_ = 0);
 
   // 16-bit init start time allows over a minute
   #if SD_INIT_TIMEOUT
@@ -400,6 +405,24 @@ bool DiskIODriver_SPI_SD::readBlock(uint32_t blockNumber, uint8_t * const dst) {
     return 0 == SDHC_CardReadBlock(dst, blockNumber);
   #endif
 
+  #if ENABLED(SD_STREAM_READS)
+    // Continue an open multi-block read if this is the next block
+    if (streaming_ && blockNumber == streamBlock_) {
+      if (readData(dst)) { lastBlock_ = streamBlock_++; return true; }
+      streamStop();       // Fall back to a single block read
+      errorCode_ = 0;
+    }
+    // Open a multi-block read on the second block of a sequential run
+    else if (!streaming_ && blockNumber == lastBlock_ + 1 && readStart(blockNumber)) {
+      streaming_ = true;
+      streamBlock_ = blockNumber;
+      if (readData(dst)) { lastBlock_ = streamBlock_++; return true; }
+      streamStop();
+      errorCode_ = 0;
+    }
+    lastBlock_ = blockNumber;
+  #endif
+
   if (type() != SD_CARD_TYPE_SDHC) blockNumber <<= 9;   // Use address if not SDHC card
 
   #if ENABLED(SD_CHECK_AND_RETRY)
@@ -585,6 +608,20 @@ bool DiskIODriver_SPI_SD::readStop() {
   return success;
 }
 
+#if ENABLED(SD_STREAM_READS)
+
+  /**
+   * End the multi-block read opened by readBlock, if any.
+   * Called before any other command is sent to the card.
+   */
+  void DiskIODriver_SPI_SD::streamStop() {
+    if (!streaming_) return;
+    streaming_ = false;
+    readStop();
+  }
+
+#endif
+
 /**
  * Set the SPI clock rate.
  *
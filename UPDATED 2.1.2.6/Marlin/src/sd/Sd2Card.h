@@ -175,6 +175,13 @@ private:
           status_,
           type_;
 
+  #if ENABLED(SD_STREAM_READS)
+    bool streaming_ = false;  // A CMD18 read is open at streamBlock_
+    uint32_t streamBlock_,    // Next block the open read will deliver
+             lastBlock_;      // Last block read by readBlock
+    void streamStop();
+  #endif
+
   // private functions
   inline uint8_t cardAcmd(const uint8_t cmd, const uint32_t arg) {
     cardCommand(CMD55, 0);
@@ -0,0 +1,64 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2024 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * Sd2Card_file.cpp - A disk image file standing in for the SD card
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if NEED_SD2CARD_FILE
+
+#include "Sd2Card_file.h"
+
+/**
+ * Open the image named by SD_IMAGE_PATH. It must hold a FAT16 or FAT32
+ * volume, with or without a partition table, in 512-byte blocks.
+ */
+bool DiskIODriver_File::init(const uint8_t, const pin_t) {
+  if (image) fclose(image);
+  image = fopen(SD_IMAGE_PATH, "r+b");
+  if (!image) return false;
+  fseek(image, 0, SEEK_END);
+  blocks = ftell(image) / 512;
+  reset_counts();
+  return true;
+}
+
+// Every command waits as long as a card would take to respond
+void DiskIODriver_File::command() {
+  commands++;
+  #if SD_IMAGE_COMMAND_US
+    delayMicroseconds(SD_IMAGE_COMMAND_US);
+  #endif
+}
+
+// Go to a block, taking as long as a card would take to move it
+bool DiskIODriver_File::seekBlock(const uint32_t block) {
+  if (!image || block >= blocks) return false;
+  #if SD_IMAGE_BLOCK_US
+    delayMicroseconds(SD_IMAGE_BLOCK_US);
+  #endif
+  return !fseek(image, long(block) * 512, SEEK_SET);
+}
+
+#endif // NEED_SD2CARD_FILE
@@ -0,0 +1,73 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2024 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * Sd2Card_file.h - A disk image file standing in for the SD card
+ *
+ * For the linux_native build, so the SD code can be run and timed on the host.
+ * Block commands can be given a delay to act more like a card on an SPI bus.
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#include "SdInfo.h"
+#include "disk_io_driver.h"
+
+#include <stdio.h>
+
+class DiskIODriver_File : public DiskIODriver {
+  public:
+    bool init(const uint8_t sckRateID=0, const pin_t chipSelectPin=0) override;
+
+    bool readCSD(csd_t *csd)                              override { return false; }
+
+    bool readStart(const uint32_t block)                  override { command(); curBlock = block; return isReady(); }
+    bool readData(uint8_t *dst)                           override { return readImage(curBlock++, dst); }
+    bool readStop()                                       override { command(); curBlock = -1; return true; }
+
+    bool writeStart(const uint32_t block, const uint32_t) override { command(); curBlock = block; return isReady(); }
+    bool writeData(const uint8_t *src)                    override { return writeImage(curBlock++, src); }
+    bool writeStop()                                      override { command(); curBlock = -1; return true; }
+
+    bool readBlock(uint32_t block, uint8_t *dst)          override { command(); return readImage(block, dst); }
+    bool writeBlock(uint32_t block, const uint8_t *src)   override { command(); return writeImage(block, src); }
+
+    uint32_t cardSize()                                   override { return blocks; }
+
+    bool isReady()                                        override { return image != nullptr; }
+
+    void idle()                                           override {}
+
+    // Activity since the last reset, for benchmarks
+    uint32_t commands, blocks_read, blocks_written;
+    void reset_counts() { commands = blocks_read = blocks_written = 0; }
+
+  private:
+    FILE *image = nullptr;
+    uint32_t blocks, curBlock;
+
+    void command();
+    bool seekBlock(const uint32_t block);
+    bool readImage(const uint32_t block, uint8_t * const dst)       { blocks_read++; return seekBlock(block) && fread(dst, 512, 1, image) == 1; }
+    bool writeImage(const uint32_t block, const uint8_t * const src) { blocks_written++; return seekBlock(block) && fwrite(src, 512, 1, image) == 1; }
+};
@@ -49,6 +49,12 @@ void (*SdBaseFile::dateTime_)(uint16_t *date, uint16_t *time) = 0;
 bool SdBaseFile::addCluster() {
   if (ENABLED(SDCARD_READONLY)) return false;
 
+  #if SD_WRITE_PREALLOCATE > 1
+    // Allocate several clusters ahead for a growing file
+    if (isFile() && vol_->allocContiguous(SD_WRITE_PREALLOCATE, &curCluster_))
+      flags_ |= F_FILE_PREALLOCATED;
+    else
+  #endif
   if (!vol_->allocContiguous(1, &curCluster_)) return false;
 
   // if first cluster of file link to directory entry
@@ -105,6 +111,10 @@ dir_t* SdBaseFile::cacheDirEntry(const uint8_t action) {
  */
 bool SdBaseFile::close() {
   bool rtn = sync();
+  #if SD_WRITE_PREALLOCATE > 1
+    // Free the clusters allocated past the end of the file
+    if (flags_ & F_FILE_PREALLOCATED) rtn = truncate(fileSize_) && rtn;
+  #endif
   type_ = FAT_FILE_TYPE_CLOSED;
   return rtn;
 }
@@ -1388,7 +1398,8 @@ int16_t SdBaseFile::read(void * const buf, uint16_t nbyte) {
         // start of new cluster
         if (curPosition_ == 0)
           curCluster_ = firstCluster_;                      // use first cluster in file
-        else if (!vol_->fatGet(curCluster_, &curCluster_))  // get next cluster from FAT
+        else if (!TERN0(SD_EXTENT_CACHE, extentCluster(curPosition_ >> (vol_->clusterSizeShift_ + 9))) // next cluster from the extent list
+              && !vol_->fatGet(curCluster_, &curCluster_))  // or get next cluster from FAT
           return -1;
       }
       block = vol_->clusterStartBlock(curCluster_) + blockOfCluster;
@@ -1930,6 +1941,13 @@ bool SdBaseFile::seekSet(const uint32_t pos) {
   nCur = (curPosition_ - 1) >> (vol_->clusterSizeShift_ + 9);
   nNew = (pos - 1) >> (vol_->clusterSizeShift_ + 9);
 
+  #if ENABLED(SD_EXTENT_CACHE)
+    if (extentCluster(nNew)) {
+      curPosition_ = pos;
+      return true;
+    }
+  #endif
+
   if (nNew < nCur || curPosition_ == 0)
     curCluster_ = firstCluster_;      // must follow chain from first cluster
   else
@@ -2217,17 +2235,30 @@ int16_t SdBaseFile::write(const void *buf, const uint16_t nbyte) {
     // max space in block
     uint16_t n = 512 - blockOffset;
 
+    #if ENABLED(SD_WRITE_BEHIND)
+      // whole blocks up to the end of the cluster
+      if (blockOffset == 0 && nToWrite >= 1024)
+        n = _MIN(uint32_t(nToWrite & ~0x1FFU), uint32_t(vol_->blocksPerCluster() - blockOfCluster) << 9);
+    #endif
+
     // lesser of space and amount to write
     NOMORE(n, nToWrite);
 
     // block for data write
     uint32_t block = vol_->clusterStartBlock(curCluster_) + blockOfCluster;
-    if (n == 512) {
-      // full block - don't need to use cache
-      if (vol_->cacheBlockNumber() == block) {
+    if (n >= 512) {
+      // full blocks - don't need to use cache
+      const uint8_t count = n >> 9;
+      if (vol_->cacheBlockNumber() - block < count) {
         // invalidate cache if block is in cache
         vol_->cacheSetBlockNumber(0xFFFFFFFF, false);
       }
+      #if ENABLED(SD_WRITE_BEHIND)
+        if (count > 1) {
+          if (!vol_->writeBlocks(block, src, count)) goto FAIL;
+        }
+        else
+      #endif
       if (!vol_->writeBlock(block, src)) goto FAIL;
     }
     else {
@@ -256,6 +256,14 @@ class SdBaseFile {
    */
   uint32_t firstCluster() const { return firstCluster_; }
 
+  #if ENABLED(SD_EXTENT_CACHE)
+    /**
+     * Keep the cluster chain of this file in the volume's extent list,
+     * so reading it takes no FAT lookups.
+     */
+    void loadExtents() { if (isFile()) vol_->loadExtents(firstCluster_); }
+  #endif
+
   /**
    * \return True if this is a directory else false.
    */
@@ -355,6 +363,7 @@ class SdBaseFile {
 
   // bits defined in flags_
   static uint8_t const F_OFLAG = (O_ACCMODE | O_APPEND | O_SYNC),   // should be 0x0F
+                       F_FILE_PREALLOCATED = 0x10,                  // clusters allocated past the end, freed by close()
                        F_FILE_DIR_DIRTY = 0x80;                     // sync of directory entry required
 
   // private data
@@ -388,6 +397,10 @@ class SdBaseFile {
     , const uint8_t oflag
   );
   bool openCachedEntry(const uint8_t dirIndex, const uint8_t oflags);
+  #if ENABLED(SD_EXTENT_CACHE)
+    // Set curCluster_ to cluster 'n' of a read-only file from the volume's extent list
+    bool extentCluster(const uint32_t n) { return isFile() && !(flags_ & O_WRITE) && vol_->chainCluster(firstCluster_, n, &curCluster_); }
+  #endif
   dir_t* readDirCache();
 
   #if ENABLED(UTF_FILENAME_SUPPORT)
@@ -120,6 +120,18 @@ bool SdVolume::allocContiguous(const uint32_t count, uint32_t * const curCluster
   return true;
 }
 
+#if ENABLED(SD_WRITE_BEHIND)
+
+  // Write consecutive blocks with one multiple block write
+  bool SdVolume::writeBlocks(const uint32_t block, const uint8_t *src, const uint8_t count) {
+    if (!sdCard_->writeStart(block, count)) return false;
+    bool ok = true;
+    for (uint8_t i = 0; ok && i < count; ++i, src += 512) ok = sdCard_->writeData(src);
+    return sdCard_->writeStop() && ok;
+  }
+
+#endif
+
 bool SdVolume::cacheFlush() {
   #if DISABLED(SDCARD_READONLY)
     if (cacheDirty_) {
@@ -159,6 +171,53 @@ bool SdVolume::chainSize(uint32_t cluster, uint32_t * const size) {
   return true;
 }
 
+#if ENABLED(SD_EXTENT_CACHE)
+
+  /**
+   * Walk the chain starting at 'first' into the extent list.
+   * Done when the file is opened, so reading it never walks the FAT.
+   */
+  void SdVolume::loadExtents(const uint32_t first) {
+    extentFirst_ = 0;
+    if (first < 2) return;
+    extents_[0] = { first, 1 };
+    extentCount_ = 1;
+    for (uint32_t c = first, next; fatGet(c, &next) && !isEOC(next); c = next) {
+      if (next == c + 1)
+        extents_[extentCount_ - 1].count++;
+      else if (extentCount_ < SD_EXTENT_COUNT)
+        extents_[extentCount_++] = { next, 1 };
+      else
+        break;  // Further clusters come from the FAT
+    }
+    extentFirst_ = first;
+  }
+
+  /**
+   * Get cluster 'n' of the chain starting at 'first' from the extent list.
+   * Return false if the list holds some other chain or 'n' is past its clusters.
+   */
+  bool SdVolume::chainCluster(const uint32_t first, uint32_t n, uint32_t * const cluster) {
+    if (first < 2 || first != extentFirst_) return false;
+    for (uint8_t i = 0; i < extentCount_; i++) {
+      if (n < extents_[i].count) { *cluster = extents_[i].cluster + n; return true; }
+      n -= extents_[i].count;
+    }
+    return false;
+  }
+
+  // Drop the extent list if it holds a cluster whose FAT entry is changing
+  void SdVolume::extentsChanged(const uint32_t cluster) {
+    if (!extentFirst_) return;
+    for (uint8_t i = 0; i < extentCount_; i++)
+      if (WITHIN(cluster, extents_[i].cluster, extents_[i].cluster + extents_[i].count - 1)) {
+        extentFirst_ = 0;
+        return;
+      }
+  }
+
+#endif
+
 // Fetch a FAT entry
 bool SdVolume::fatGet(const uint32_t cluster, uint32_t * const value) {
   uint32_t lba;
@@ -187,8 +246,20 @@ bool SdVolume::fatGet(const uint32_t cluster, uint32_t * const value) {
   else
     return false;
 
-  if (lba != cacheBlockNumber_ && !cacheRawBlock(lba, CACHE_FOR_READ))
-    return false;
+  #if ENABLED(SD_EXTENT_CACHE)
+    // Read from the FAT cache unless the block cache holds a (maybe changed) copy
+    if (lba != cacheBlockNumber_) {
+      if (lba != fatCacheBlock_) {
+        if (!sdCard_->readBlock(lba, fatCache_.data)) return false;
+        fatCacheBlock_ = lba;
+      }
+      *value = (fatType_ == 16) ? fatCache_.fat16[cluster & 0xFF] : (fatCache_.fat32[cluster & 0x7F] & FAT32MASK);
+      return true;
+    }
+  #else
+    if (lba != cacheBlockNumber_ && !cacheRawBlock(lba, CACHE_FOR_READ))
+      return false;
+  #endif
 
   *value = (fatType_ == 16) ? cacheBuffer_.fat16[cluster & 0xFF] : (cacheBuffer_.fat32[cluster & 0x7F] & FAT32MASK);
   return true;
@@ -202,6 +273,12 @@ bool SdVolume::fatPut(const uint32_t cluster, const uint32_t value) {
   // error if reserved cluster
   if (cluster < 2) return false;
 
+  #if ENABLED(SD_EXTENT_CACHE)
+    // The FAT is changing so drop the cached copies
+    fatCacheBlock_ = 0xFFFFFFFF;
+    extentsChanged(cluster);
+  #endif
+
   // error if not in FAT
   if (cluster > (clusterCount_ + 1)) return false;
 
@@ -336,6 +413,10 @@ bool SdVolume::init(DiskIODriver * const dev, const uint8_t part) {
   cacheDirty_ = 0;  // cacheFlush() will write block if true
   cacheMirrorBlock_ = 0;
   cacheBlockNumber_ = 0xFFFFFFFF;
+  #if ENABLED(SD_EXTENT_CACHE)
+    fatCacheBlock_ = 0xFFFFFFFF;
+    extentFirst_ = 0;
+  #endif
 
   // if part == 0 assume super floppy with FAT boot sector in block zero
   // if part > 0 assume mbr volume with partition table
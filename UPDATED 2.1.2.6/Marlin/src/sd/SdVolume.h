@@ -38,7 +38,9 @@
   #include "usb_flashdrive/Sd2Card_FlashDrive.h"
 #endif
 
-#if NEED_SD2CARD_SDIO
+#if NEED_SD2CARD_FILE
+  #include "Sd2Card_file.h"
+#elif NEED_SD2CARD_SDIO
   #include "Sd2Card_sdio.h"
 #elif NEED_SD2CARD_SPI
   #include "Sd2Card.h"
@@ -152,6 +154,15 @@ class SdVolume {
     static uint32_t cacheMirrorBlock_;  // block number for mirror FAT
   #endif
 
+  #if ENABLED(SD_EXTENT_CACHE)
+    cache_t fatCache_;            // FAT block cache, so data reads don't evict the FAT
+    uint32_t fatCacheBlock_;      // Logical number of the block in fatCache_
+    typedef struct { uint32_t cluster, count; } extent_t;  // A run of contiguous clusters
+    extent_t extents_[SD_EXTENT_COUNT]; // The cluster chain of the file being read
+    uint8_t extentCount_;         // Number of runs in extents_
+    uint32_t extentFirst_;        // First cluster of the chain in extents_, or 0
+  #endif
+
   uint32_t allocSearchStart_;   // start cluster for alloc search
   uint8_t blocksPerCluster_;    // cluster size in blocks
   uint32_t blocksPerFat_;       // FAT size in blocks
@@ -187,6 +198,11 @@ class SdVolume {
   }
   void cacheSetDirty() { cacheDirty_ |= CACHE_FOR_WRITE; }
   bool chainSize(uint32_t cluster, uint32_t * const size);
+  #if ENABLED(SD_EXTENT_CACHE)
+    void loadExtents(const uint32_t first);
+    bool chainCluster(const uint32_t first, uint32_t n, uint32_t * const cluster);
+    void extentsChanged(const uint32_t cluster);
+  #endif
   bool fatGet(const uint32_t cluster, uint32_t * const value);
   bool fatPut(const uint32_t cluster, const uint32_t value);
   bool fatPutEOC(const uint32_t cluster) { return fatPut(cluster, 0x0FFFFFFF); }
@@ -198,6 +214,9 @@ class SdVolume {
   }
   bool readBlock(const uint32_t block, uint8_t * const dst) { return sdCard_->readBlock(block, dst); }
   bool writeBlock(const uint32_t block, const uint8_t * const dst) { return sdCard_->writeBlock(block, dst); }
+  #if ENABLED(SD_WRITE_BEHIND)
+    bool writeBlocks(const uint32_t block, const uint8_t *src, const uint8_t count);
+  #endif
 };
 
 using MarlinVolume = SdVolume;
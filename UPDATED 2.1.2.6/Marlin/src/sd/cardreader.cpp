@@ -87,6 +87,25 @@ MediaFile CardReader::root, CardReader::workDir, CardReader::workDirParents[MAX_
 uint8_t CardReader::workDirDepth;
 int16_t CardReader::nrItems = -1;
 
+#if ENABLED(SD_DIR_INDEX)
+  uint16_t CardReader::dir_index[SD_DIR_INDEX_SIZE];
+#endif
+
+#if ENABLED(SD_LISTING_CACHE)
+  #define LISTING_OVERFLOW 0xFFFF
+  uint8_t CardReader::listing_cache[SD_LISTING_CACHE_SIZE];
+  uint16_t CardReader::listing_used; // = 0
+#endif
+
+#if ENABLED(M20_PAGINATION)
+  uint16_t CardReader::list_index, CardReader::list_first, CardReader::list_end;
+#endif
+
+#if ENABLED(SD_WRITE_BEHIND)
+  uint8_t CardReader::wb_buffer[(SD_WRITE_BEHIND_BLOCKS) * 512];
+  uint16_t CardReader::wb_tail, CardReader::wb_count;
+#endif
+
 #if ENABLED(SDCARD_SORT_ALPHA)
 
   int16_t CardReader::sort_count;
@@ -132,7 +151,7 @@ int16_t CardReader::nrItems = -1;
   DiskIODriver_USBFlash CardReader::media_driver_usbFlash;
 #endif
 
-#if NEED_SD2CARD_SDIO || NEED_SD2CARD_SPI
+#if NEED_SD2CARD_SDIO || NEED_SD2CARD_SPI || NEED_SD2CARD_FILE
   CardReader::sdcard_driver_t CardReader::media_driver_sdcard;
 #endif
 
@@ -238,7 +257,16 @@ int16_t CardReader::countVisibleItems(MediaFile dir) {
   dir_t p;
   int16_t c = 0;
   dir.rewind();
-  while (dir.readDir(&p, longFilename) > 0) c += is_visible_entity(p);
+  #if ENABLED(SD_DIR_INDEX)
+    // Note where each item starts so selectFileByIndex can seek to it
+    for (uint32_t pos = 0; dir.readDir(&p, longFilename) > 0; pos = dir.curPosition())
+      if (is_visible_entity(p)) {
+        if (c < SD_DIR_INDEX_SIZE) dir_index[c] = pos / sizeof(dir_t);
+        c++;
+      }
+  #else
+    while (dir.readDir(&p, longFilename) > 0) c += is_visible_entity(p);
+  #endif
   return c;
 }
 
@@ -283,6 +311,45 @@ void CardReader::selectByName(MediaFile dir, const char * const match) {
  */
 void CardReader::printListing(MediaFile parent, const char * const prepend, const uint8_t lsflags
   OPTARG(LONG_FILENAME_HOST_SUPPORT, const char * const prependLong/*=nullptr*/)
+) {
+  dir_t p;
+
+  #if ENABLED(SD_LISTING_CACHE)
+    // List the root folder from RAM, if it fits
+    if (!prepend) {
+      if (!listing_used) cacheListing(parent);
+      if (listing_used != LISTING_OVERFLOW) {
+        for (uint16_t i = 0; i < listing_used;) {
+          listing_item_t item;
+          memcpy(&item, &listing_cache[i], sizeof(item));
+          i += sizeof(item);
+          memset(&p, 0, sizeof(p));
+          memcpy(p.name, item.name, sizeof(p.name));
+          p.attributes = item.attributes;
+          p.fileSize = item.fileSize;
+          p.creationDate = p.lastWriteDate = item.date;
+          p.creationTime = p.lastWriteTime = item.time;
+          memcpy(longFilename, &listing_cache[i], item.lfnLength);
+          longFilename[item.lfnLength] = '\0';
+          i += item.lfnLength;
+          if (!printListingItem(parent, p, item.index, prepend, lsflags OPTARG(LONG_FILENAME_HOST_SUPPORT, prependLong))) return;
+        }
+        return;
+      }
+      parent.rewind();
+    }
+  #endif
+
+  while (parent.readDir(&p, longFilename) > 0)
+    if (!printListingItem(parent, p, parent.curPosition() / sizeof(dir_t) - 1, prepend, lsflags OPTARG(LONG_FILENAME_HOST_SUPPORT, prependLong))) return;
+}
+
+/**
+ * Print one item for printListing, diving into folders.
+ * Return 'false' to end the listing of the parent folder.
+ */
+bool CardReader::printListingItem(MediaFile &parent, const dir_t &p, const uint16_t index, const char * const prepend, const uint8_t lsflags
+  OPTARG(LONG_FILENAME_HOST_SUPPORT, const char * const prependLong)
 ) {
   const bool includeTime = TERN0(M20_TIMESTAMP_SUPPORT, TEST(lsflags, LS_TIMESTAMP));
   #if ENABLED(LONG_FILENAME_HOST_SUPPORT)
@@ -292,74 +359,120 @@ void CardReader::printListing(MediaFile parent, const char * const prepend, cons
     const bool onlyBin = TEST(lsflags, LS_ONLY_BIN);
   #endif
   UNUSED(lsflags);
-  dir_t p;
-  while (parent.readDir(&p, longFilename) > 0) {
-    if (DIR_IS_SUBDIR(&p)) {
-
-      const size_t lenPrepend = prepend ? strlen(prepend) + 1 : 0;
-      // Allocate enough stack space for the full path including / separator
-      char path[lenPrepend + FILENAME_LENGTH];
-      if (prepend) { strcpy(path, prepend); path[lenPrepend - 1] = '/'; }
-      char* dosFilename = path + lenPrepend;
-      createFilename(dosFilename, p);
-
-      // Get a new directory object using the full path
-      // and dive recursively into it.
-      MediaFile child; // child.close() in destructor
-      if (child.open(&parent, dosFilename, O_READ)) {
-        #if ENABLED(LONG_FILENAME_HOST_SUPPORT)
-          if (includeLong) {
-            const size_t lenPrependLong = prependLong ? strlen(prependLong) + 1 : 0;
-            // Allocate enough stack space for the full long path including / separator
-            char pathLong[lenPrependLong + strlen(longFilename) + 1];
-            if (prependLong) { strcpy(pathLong, prependLong); pathLong[lenPrependLong - 1] = '/'; }
-            strcpy(pathLong + lenPrependLong, longFilename);
-            printListing(child, path, lsflags, pathLong);
-            continue;
-          }
-        #endif
-        printListing(child, path, lsflags);
-      }
-      else {
-        SERIAL_ECHO_MSG(STR_SD_CANT_OPEN_SUBDIR, dosFilename);
-        return;
-      }
-    }
-    else if (is_visible_entity(p OPTARG(CUSTOM_FIRMWARE_UPLOAD, onlyBin))) {
-      if (prepend) { SERIAL_ECHO(prepend); SERIAL_CHAR('/'); }
-      SERIAL_ECHO(createFilename(filename, p));
-      SERIAL_CHAR(' ');
-      SERIAL_ECHO(p.fileSize);
-      if (includeTime) {
-        SERIAL_CHAR(' ');
-        uint16_t crmodDate = p.lastWriteDate, crmodTime = p.lastWriteTime;
-        if (crmodDate < p.creationDate || (crmodDate == p.creationDate && crmodTime < p.creationTime)) {
-          crmodDate = p.creationDate;
-          crmodTime = p.creationTime;
-        }
-        SERIAL_ECHOPGM("0x", hex_word(crmodDate));
-        print_hex_word(crmodTime);
-      }
+  if (DIR_IS_SUBDIR(&p)) {
+
+    const size_t lenPrepend = prepend ? strlen(prepend) + 1 : 0;
+    // Allocate enough stack space for the full path including / separator
+    char path[lenPrepend + FILENAME_LENGTH];
+    if (prepend) { strcpy(path, prepend); path[lenPrepend - 1] = '/'; }
+    char* dosFilename = path + lenPrepend;
+    createFilename(dosFilename, p);
+
+    // Get a new directory object by its entry in the parent
+    // and dive recursively into it.
+    MediaFile child; // child.close() in destructor
+    if (child.open(&parent, index, O_READ)) {
       #if ENABLED(LONG_FILENAME_HOST_SUPPORT)
         if (includeLong) {
-          SERIAL_CHAR(' ');
-          if (prependLong) { SERIAL_ECHO(prependLong); SERIAL_CHAR('/'); }
-          SERIAL_ECHO(longFilename[0] ? longFilename : filename);
+          const size_t lenPrependLong = prependLong ? strlen(prependLong) + 1 : 0;
+          // Allocate enough stack space for the full long path including / separator
+          char pathLong[lenPrependLong + strlen(longFilename) + 1];
+          if (prependLong) { strcpy(pathLong, prependLong); pathLong[lenPrependLong - 1] = '/'; }
+          strcpy(pathLong + lenPrependLong, longFilename);
+          printListing(child, path, lsflags, pathLong);
         }
+        else
       #endif
-      SERIAL_EOL();
+          printListing(child, path, lsflags);
+      return TERN1(M20_PAGINATION, list_index <= list_end);
     }
+    SERIAL_ECHO_MSG(STR_SD_CANT_OPEN_SUBDIR, dosFilename);
+    return false;
+  }
+  else if (is_visible_entity(p OPTARG(CUSTOM_FIRMWARE_UPLOAD, onlyBin))) {
+    #if ENABLED(M20_PAGINATION)
+      if (list_index == list_end) { list_index++; return false; } // More items to list
+      if (list_index++ < list_first) return true;                 // Skip to the first item
+    #endif
+    if (prepend) { SERIAL_ECHO(prepend); SERIAL_CHAR('/'); }
+    SERIAL_ECHO(createFilename(filename, p));
+    SERIAL_CHAR(' ');
+    SERIAL_ECHO(p.fileSize);
+    if (includeTime) {
+      SERIAL_CHAR(' ');
+      uint16_t crmodDate = p.lastWriteDate, crmodTime = p.lastWriteTime;
+      if (crmodDate < p.creationDate || (crmodDate == p.creationDate && crmodTime < p.creationTime)) {
+        crmodDate = p.creationDate;
+        crmodTime = p.creationTime;
+      }
+      SERIAL_ECHOPGM("0x", hex_word(crmodDate));
+      print_hex_word(crmodTime);
+    }
+    #if ENABLED(LONG_FILENAME_HOST_SUPPORT)
+      if (includeLong) {
+        SERIAL_CHAR(' ');
+        if (prependLong) { SERIAL_ECHO(prependLong); SERIAL_CHAR('/'); }
+        SERIAL_ECHO(longFilename[0] ? longFilename : filename);
+      }
+    #endif
+    SERIAL_EOL();
   }
+  return true;
 }
 
+#if ENABLED(SD_LISTING_CACHE)
+
+  //
+  // Keep the folders and visible files of a folder with their long
+  // filenames, sizes and dates, unless they don't fit the cache.
+  //
+  void CardReader::cacheListing(MediaFile dir) {
+    dir_t p;
+    uint16_t used = 0;
+    dir.rewind();
+    while (dir.readDir(&p, longFilename) > 0) {
+      if (!DIR_IS_SUBDIR(&p) && !is_visible_entity(p)) continue;
+      listing_item_t item;
+      item.lfnLength = TERN0(LONG_FILENAME_HOST_SUPPORT, strlen(longFilename));
+      if (used + sizeof(item) + item.lfnLength > SD_LISTING_CACHE_SIZE) {
+        listing_used = LISTING_OVERFLOW;
+        return;
+      }
+      memcpy(item.name, p.name, sizeof(item.name));
+      item.attributes = p.attributes;
+      item.fileSize = p.fileSize;
+      const bool created = p.lastWriteDate < p.creationDate || (p.lastWriteDate == p.creationDate && p.lastWriteTime < p.creationTime);
+      item.date = created ? p.creationDate : p.lastWriteDate;
+      item.time = created ? p.creationTime : p.lastWriteTime;
+      item.index = dir.curPosition() / sizeof(dir_t) - 1;
+      memcpy(&listing_cache[used], &item, sizeof(item));
+      used += sizeof(item);
+      memcpy(&listing_cache[used], longFilename, item.lfnLength);
+      used += item.lfnLength;
+    }
+    listing_used = used;
+  }
+
+#endif
+
 //
-// List all files on the SD card
+// List all files on the SD card.
+// With M20_PAGINATION return the index of the next item, if any remain.
 //
-void CardReader::ls(const uint8_t lsflags/*=0*/) {
+uint16_t CardReader::ls(const uint8_t lsflags/*=0*/ OPTARG(M20_PAGINATION, const uint16_t first/*=0*/, const uint16_t count/*=0*/)) {
   if (flag.mounted) {
+    #if ENABLED(M20_PAGINATION)
+      list_index = 0;
+      list_first = first;
+      list_end = count ? _MIN(uint32_t(first) + count, 0xFFFFU) : 0xFFFFU;
+    #endif
     root.rewind();
     printListing(root, nullptr, lsflags);
+    #if ENABLED(M20_PAGINATION)
+      if (list_index > list_end) return list_end;
+    #endif
   }
+  return 0;
 }
 
 #if ENABLED(LONG_FILENAME_HOST_SUPPORT)
@@ -448,6 +561,7 @@ void CardReader::printSelectedFilename() {
 void CardReader::mount() {
   flag.mounted = false;
   nrItems = -1;
+  TERN_(SD_LISTING_CACHE, clearListing());
   if (root.isOpen()) root.close();
 
   if (!driver->init(SD_SPI_SPEED, SDSS)
@@ -552,6 +666,7 @@ void CardReader::release() {
   flag.mounted = false;
   flag.workDirIsRoot = true;
   nrItems = -1;
+  TERN_(SD_LISTING_CACHE, clearListing());
   SERIAL_ECHO_MSG(STR_SD_CARD_RELEASED);
 
   TERN_(NO_SD_DETECT, ui.refresh());
@@ -697,6 +812,7 @@ void CardReader::openFileRead(const char * const path, const uint8_t subcall_typ
   if (file.open(diveDir, fname, O_READ)) {
     filesize = file.fileSize();
     sdpos = 0;
+    TERN_(SD_EXTENT_CACHE, file.loadExtents());
 
     { // Don't remove this block, as the PORT_REDIRECT is a RAII
       PORT_REDIRECT(SerialMask::All);
@@ -733,6 +849,9 @@ void CardReader::openFileWrite(const char * const path) {
   #if DISABLED(SDCARD_READONLY)
     if (file.open(diveDir, fname, O_CREAT | O_APPEND | O_WRITE | O_TRUNC)) {
       flag.saving = true;
+      nrItems = -1;
+      TERN_(SD_LISTING_CACHE, clearListing());
+      TERN_(SD_WRITE_BEHIND, wb_tail = wb_count = 0);
       selectFileByName(fname);
       TERN_(EMERGENCY_PARSER, emergency_parser.disable());
       echo_write_to_file(fname);
@@ -788,6 +907,8 @@ void CardReader::removeFile(const char * const name) {
     if (file.remove(itsDirPtr, fname)) {
       SERIAL_ECHOLNPGM("File deleted:", fname);
       sdpos = 0;
+      nrItems = -1;
+      TERN_(SD_LISTING_CACHE, clearListing());
       TERN_(SDCARD_SORT_ALPHA, presort());
     }
     else
@@ -818,11 +939,58 @@ void CardReader::write_command(char * const buf) {
   end[1] = '\r';
   end[2] = '\n';
   end[3] = '\0';
-  file.write(begin);
 
-  if (file.writeError) SERIAL_ERROR_MSG(STR_SD_ERR_WRITE_TO_FILE);
+  #if ENABLED(SD_WRITE_BEHIND)
+
+    // Make room by writing whole blocks now. The rest waits for idle().
+    const uint16_t len = end + 3 - begin;
+    if (len > sizeof(wb_buffer) - wb_count && !wb_flush(false)) {
+      SERIAL_ERROR_MSG(STR_SD_ERR_WRITE_TO_FILE);
+      return;
+    }
+
+    // Copy the line into the ring, wrapping at the end
+    uint16_t head = wb_tail + wb_count;
+    if (head >= sizeof(wb_buffer)) head -= sizeof(wb_buffer);
+    const uint16_t part = _MIN(len, uint16_t(sizeof(wb_buffer) - head));
+    memcpy(&wb_buffer[head], begin, part);
+    memcpy(wb_buffer, begin + part, len - part);
+    wb_count += len;
+
+  #else
+
+    file.write(begin);
+
+    if (file.writeError) SERIAL_ERROR_MSG(STR_SD_ERR_WRITE_TO_FILE);
+
+  #endif
 }
 
+#if ENABLED(SD_WRITE_BEHIND)
+
+  /**
+   * Write the whole blocks waiting in the buffer to the file,
+   * or all the bytes if the file is being closed.
+   * The ring size is a whole number of blocks, so each write
+   * ends on a block boundary and needs no read-modify-write.
+   */
+  bool CardReader::wb_flush(const bool all) {
+    while (wb_count >= 512 || (all && wb_count)) {
+      uint16_t n = _MIN(wb_count, uint16_t(sizeof(wb_buffer) - wb_tail));
+      if (!all) n &= ~0x1FFU;
+      if (file.write(&wb_buffer[wb_tail], n) != int16_t(n)) {
+        wb_tail = wb_count = 0;   // Drop what can't be written
+        return false;
+      }
+      wb_tail += n;
+      if (wb_tail >= sizeof(wb_buffer)) wb_tail = 0;
+      wb_count -= n;
+    }
+    return true;
+  }
+
+#endif
+
 #if DISABLED(NO_SD_AUTOSTART)
   /**
    * Run all the auto#.g files. Called:
@@ -867,8 +1035,12 @@ void CardReader::write_command(char * const buf) {
 #endif
 
 void CardReader::closefile(const bool store_location/*=false*/) {
+  #if ENABLED(SD_WRITE_BEHIND)
+    if (wb_count && !wb_flush(true)) SERIAL_ERROR_MSG(STR_SD_ERR_WRITE_TO_FILE);
+  #endif
   file.sync();
   file.close();
+  TERN_(SD_LISTING_CACHE, if (flag.saving) clearListing()); // The file size has changed
   flag.saving = flag.logging = false;
   sdpos = 0;
   TERN_(EMERGENCY_PARSER, emergency_parser.enable());
@@ -892,6 +1064,15 @@ void CardReader::selectFileByIndex(const int16_t nr) {
       return;
     }
   #endif
+  #if ENABLED(SD_DIR_INDEX)
+    // The count builds the index. Seek to the item, or to the last indexed item and count from there.
+    if (WITHIN(nr, 0, get_num_items() - 1)) {
+      const int16_t i = _MIN(nr, SD_DIR_INDEX_SIZE - 1);
+      workDir.seekSet(uint32_t(dir_index[i]) * sizeof(dir_t));
+      selectByIndex(workDir, nr - i);
+      return;
+    }
+  #endif
   workDir.rewind();
   selectByIndex(workDir, nr);
 }
@@ -1010,6 +1191,7 @@ const char* CardReader::diveToFile(const bool update_cwd, MediaFile* &inDirPtr,
     workDir = *inDirPtr;
     DEBUG_ECHOLNPGM(" final workDir = ", hex_address((void*)inDirPtr));
     flag.workDirIsRoot = (workDirDepth == 0);
+    nrItems = -1;
     TERN_(SDCARD_SORT_ALPHA, presort());
   }
 
@@ -1346,6 +1528,70 @@ void CardReader::fileHasFinished() {
     }
   }
 
+  #if ENABLED(POWER_LOSS_JOURNAL)
+
+    /**
+     * Get the first block of the journal, if the recovery file
+     * is a whole journal in contiguous clusters.
+     */
+    bool CardReader::findJobRecoveryJournal(uint32_t &block) {
+      if (!isMounted() || recovery.file.isOpen()) return false;
+      if (!recovery.file.open(&root, recovery.filename, O_READ)) return false;
+      uint32_t end;
+      const bool found = recovery.file.fileSize() == (POWER_LOSS_JOURNAL_BLOCKS) * 512UL
+                      && recovery.file.contiguousRange(&block, &end);
+      recovery.file.close();
+      return found;
+    }
+
+    /**
+     * Get the journal for a new job, reusing the last one if possible.
+     * The journal is then written in place, with no FAT or directory updates.
+     * A new journal, or one with records that can't be told apart from new ones, is cleared.
+     */
+    bool CardReader::startJobRecoveryJournal(uint32_t &block, const bool clear) {
+      if (findJobRecoveryJournal(block))
+        return !clear || clearJobRecoveryJournal(block, POWER_LOSS_JOURNAL_BLOCKS);
+
+      if (recovery.file.open(&root, recovery.filename, O_RDWR)) recovery.file.remove();
+      uint32_t end;
+      const bool made = recovery.file.createContiguous(&root, recovery.filename, (POWER_LOSS_JOURNAL_BLOCKS) * 512UL)
+                     && recovery.file.contiguousRange(&block, &end);
+      recovery.file.close();
+      if (!made) { openFailed(recovery.filename); return false; }
+      return clearJobRecoveryJournal(block, POWER_LOSS_JOURNAL_BLOCKS);
+    }
+
+    // Clear the first blocks of a journal with one multi-block write
+    bool CardReader::clearJobRecoveryJournal(const uint32_t block, const uint8_t count) {
+      cache_t * const buf = volume.cacheClear();
+      if (!buf) return false;
+      ZERO(buf->data);
+      if (!driver->writeStart(block, count)) return false;
+      for (uint8_t b = 0; b < count; ++b)
+        if (!driver->writeData(buf->data)) return false;
+      return driver->writeStop();
+    }
+
+    // Read the start of a journal block through the volume cache buffer
+    bool CardReader::readJobRecoveryBlock(const uint32_t block, void * const data, const uint16_t size) {
+      cache_t * const buf = volume.cacheClear();
+      if (!buf || !driver->readBlock(block, buf->data)) return false;
+      memcpy(data, buf->data, size);
+      return true;
+    }
+
+    // Write a journal block from the volume cache buffer, padded with zeros
+    bool CardReader::writeJobRecoveryBlock(const uint32_t block, const void * const data, const uint16_t size) {
+      cache_t * const buf = volume.cacheClear();
+      if (!buf) return false;
+      memcpy(buf->data, data, size);
+      memset(buf->data + size, 0, sizeof(buf->data) - size);
+      return driver->writeBlock(block, buf->data);
+    }
+
+  #endif // POWER_LOSS_JOURNAL
+
 #endif // POWER_LOSS_RECOVERY
 
 #endif // HAS_MEDIA
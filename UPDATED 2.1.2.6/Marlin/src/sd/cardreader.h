@@ -54,7 +54,9 @@ extern const char M23_STR[], M24_STR[];
   #include "usb_flashdrive/Sd2Card_FlashDrive.h"
 #endif
 
-#if NEED_SD2CARD_SDIO
+#if NEED_SD2CARD_FILE
+  #include "Sd2Card_file.h"
+#elif NEED_SD2CARD_SDIO
   #include "Sd2Card_sdio.h"
 #elif NEED_SD2CARD_SPI
   #include "Sd2Card.h"
@@ -129,6 +131,11 @@ public:
   static void openLogFile(const char * const path);
   static void write_command(char * const buf);
 
+  #if ENABLED(SD_WRITE_BEHIND)
+    // Write buffered lines to the file from idle() once half the buffer is used
+    static void write_behind() { if (wb_count >= sizeof(wb_buffer) / 2) wb_flush(false); }
+  #endif
+
   #if DISABLED(NO_SD_AUTOSTART)     // Auto-Start auto#.g file handling
     static uint8_t autofile_index;  // Next auto#.g index to run, plus one. Ignored by autofile_check when zero.
     static void autofile_begin();   // Begin check. Called automatically after boot-up.
@@ -210,12 +217,19 @@ public:
     }
   #endif
 
-  static void ls(const uint8_t lsflags=0);
+  static uint16_t ls(const uint8_t lsflags=0 OPTARG(M20_PAGINATION, const uint16_t first=0, const uint16_t count=0));
 
   #if ENABLED(POWER_LOSS_RECOVERY)
     static bool jobRecoverFileExists();
     static void openJobRecoveryFile(const bool read);
     static void removeJobRecoveryFile();
+    #if ENABLED(POWER_LOSS_JOURNAL)
+      static bool findJobRecoveryJournal(uint32_t &block);
+      static bool startJobRecoveryJournal(uint32_t &block, const bool clear);
+      static bool clearJobRecoveryJournal(const uint32_t block, const uint8_t count);
+      static bool readJobRecoveryBlock(const uint32_t block, void * const data, const uint16_t size);
+      static bool writeJobRecoveryBlock(const uint32_t block, const void * const data, const uint16_t size);
+    #endif
   #endif
 
   // Binary flag for the current file
@@ -225,6 +239,7 @@ public:
   // Current Working Dir - Set by cd, cdup, cdroot, and diveToFile(true, ...)
   static char* getWorkDirName()  { workDir.getDosName(filename); return filename; }
   static MediaFile& getWorkDir()    { return workDir.isOpen() ? workDir : root; }
+  static MediaFile& getFile()       { return file; }
 
   // Print File stats
   static uint32_t getFileSize()  { return filesize; }
@@ -254,7 +269,10 @@ public:
     static DiskIODriver_USBFlash media_driver_usbFlash;
   #endif
 
-  #if NEED_SD2CARD_SDIO || NEED_SD2CARD_SPI
+  #if NEED_SD2CARD_FILE
+    typedef DiskIODriver_File sdcard_driver_t;
+    static sdcard_driver_t media_driver_sdcard;
+  #elif NEED_SD2CARD_SDIO || NEED_SD2CARD_SPI
     typedef TERN(NEED_SD2CARD_SDIO, DiskIODriver_SDIO, DiskIODriver_SPI_SD) sdcard_driver_t;
     static sdcard_driver_t media_driver_sdcard;
   #endif
@@ -267,6 +285,37 @@ private:
   static uint8_t workDirDepth;
   static int16_t nrItems; // Cache the total count
 
+  #if ENABLED(SD_DIR_INDEX)
+    static uint16_t dir_index[SD_DIR_INDEX_SIZE]; // Directory entry number of each item in workDir
+  #endif
+
+  #if ENABLED(SD_LISTING_CACHE)
+    // Root folder items for M20, kept until the card is changed
+    typedef struct {
+      uint8_t name[11], attributes;
+      uint32_t fileSize;
+      uint16_t date, time,        // Newest of created / modified
+               index;             // Directory entry number
+      uint8_t lfnLength;          // Long filename bytes that follow
+    } listing_item_t;
+    static uint8_t listing_cache[SD_LISTING_CACHE_SIZE];
+    static uint16_t listing_used; // Bytes used, 0 if not built, or LISTING_OVERFLOW
+    static void cacheListing(MediaFile dir);
+    static void clearListing() { listing_used = 0; }
+  #endif
+
+  #if ENABLED(M20_PAGINATION)
+    static uint16_t list_index, list_first, list_end; // Items counted, first to print, and one past the last
+  #endif
+
+  #if ENABLED(SD_WRITE_BEHIND)
+    // Lines for the file being saved. Only whole blocks are written until the file is closed.
+    static uint8_t wb_buffer[(SD_WRITE_BEHIND_BLOCKS) * 512];
+    static uint16_t wb_tail,      // Next byte to write to the file
+                    wb_count;     // Bytes waiting to be written
+    static bool wb_flush(const bool all);
+  #endif
+
   //
   // Alphabetical file and folder sorting
   //
@@ -349,6 +398,10 @@ private:
     MediaFile parent, const char * const prepend, const uint8_t lsflags
     OPTARG(LONG_FILENAME_HOST_SUPPORT, const char * const prependLong=nullptr)
   );
+  static bool printListingItem(
+    MediaFile &parent, const dir_t &p, const uint16_t index, const char * const prepend, const uint8_t lsflags
+    OPTARG(LONG_FILENAME_HOST_SUPPORT, const char * const prependLong)
+  );
 
   #if ENABLED(SDCARD_SORT_ALPHA)
     static void flush_presort();
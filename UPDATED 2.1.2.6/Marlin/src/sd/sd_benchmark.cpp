@@ -0,0 +1,160 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2024 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * sd_benchmark.cpp - Time the SD stack against a disk image
+ *
+ * Run at startup by MARLIN_TEST_BUILD with SD_IMAGE_DRIVER. Each step reports
+ * the time taken and the card commands and blocks it needed, so changes to the
+ * SD code can be compared on the host with the same image and block delays.
+ * The file written is read back and checked against the lines it was given, and
+ * must hold no more clusters than its size needs (SD_WRITE_PREALLOCATE).
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(MARLIN_TEST_BUILD) && NEED_SD2CARD_FILE
+
+#include "sd_benchmark.h"
+#include "cardreader.h"
+
+#define BENCH_FILE      "BENCH.GCO"
+#define BENCH_FILE_KB   256   // Size of the file written and read back
+#define BENCH_DIR_FILES 32    // Extra files for the directory scan
+
+static DiskIODriver_File &image = card.media_driver_sdcard;
+static millis_t bench_ms;
+
+static void bench_start() { image.reset_counts(); bench_ms = millis(); }
+
+static void bench_report(FSTR_P const name, const uint32_t bytes=0) {
+  const millis_t ms = millis() - bench_ms;
+  SERIAL_ECHOPGM("SD benchmark ");
+  SERIAL_ECHOF(name);
+  SERIAL_ECHOPGM(": ", ms, " ms");
+  if (bytes) SERIAL_ECHOPGM(", ", uint32_t(bytes * 1000ULL / _MAX(ms, 1UL)), " B/s");
+  SERIAL_ECHOLNPGM(", ", image.commands, " commands, ", image.blocks_read, " blocks read, ", image.blocks_written, " written");
+}
+
+// Line n of a benchmark file, with room for the "\r\n" that write_command adds
+static void bench_line(char * const line, const unsigned n) {
+  sprintf_P(line, PSTR("G1 X%u.%03u Y%u.%03u E0.%05u"), n % 200, n % 1000, n * 7 % 200, n * 3 % 1000, n % 100000);
+}
+
+// Write a file of short G-code lines the way M28 does
+static uint32_t bench_write(const char * const path, const uint32_t size) {
+  card.openFileWrite(path);
+  if (!card.isFileOpen()) return 0;
+  char line[48];
+  uint32_t written = 0;
+  for (unsigned n = 0; written < size; ++n) {
+    bench_line(line, n);
+    written += strlen(line) + 2;  // With "\r\n"
+    card.write_command(line);
+  }
+  card.closefile();
+  return written;
+}
+
+// Read a benchmark file back and compare it with the lines written
+static void bench_verify(const char * const path, const uint32_t size) {
+  card.openFileRead(path);
+  if (!card.isFileOpen()) { SERIAL_ECHOLNPGM("SD benchmark verify: Can't open ", path, " FAIL"); return; }
+  char line[48];
+  uint8_t len = 0, pos = 0;
+  unsigned n = 0;
+  uint32_t got = 0;
+  bool match = true;
+  for (int16_t c; match && (c = card.get()) >= 0; ++got) {
+    if (pos >= len) {
+      bench_line(line, n++);
+      strcat_P(line, PSTR("\r\n"));
+      len = strlen(line);
+      pos = 0;
+    }
+    match = (c == line[pos++]);
+  }
+  card.closefile();
+  if (!match) SERIAL_ECHOLNPGM("SD benchmark verify: Mismatch at byte ", got - 1, " FAIL");
+  else if (got != size || pos != len) SERIAL_ECHOLNPGM("SD benchmark verify: ", got, " bytes read (expect ", size, ") FAIL");
+  else SERIAL_ECHOLNPGM("SD benchmark verify: ", got, " bytes PASS");
+}
+
+void sd_benchmark() {
+  if (!card.isMounted()) card.mount();
+  if (!card.isMounted()) { SERIAL_ECHOLNPGM("SD benchmark: No volume in " SD_IMAGE_PATH); return; }
+  card.cdroot();
+
+  SdVolume * const vol = card.getWorkDir().volume();
+  const int32_t free_before = vol->freeClusterCount();
+
+  // Writes
+  bench_start();
+  const uint32_t size = bench_write(BENCH_FILE, BENCH_FILE_KB * 1024UL);
+  bench_report(F("write"), size);
+
+  // Clusters allocated ahead of the writes are freed when the file is closed
+  if (free_before >= 0) {
+    const uint32_t cluster_bytes = uint32_t(vol->blocksPerCluster()) << 9,
+                   need = (size + cluster_bytes - 1) / cluster_bytes,
+                   used = free_before - vol->freeClusterCount();
+    SERIAL_ECHOLNPGM("SD benchmark clusters: ", used, " used (expect ", need, ") ", used == need ? F("PASS") : F("FAIL"));
+  }
+
+  // Streaming reads, as for a print
+  card.openFileRead(BENCH_FILE);
+  if (card.isFileOpen()) {
+    uint32_t got = 0;
+    bench_start();
+    while (card.get() >= 0) ++got;
+    bench_report(F("read"), got);
+    card.closefile();
+  }
+  bench_verify(BENCH_FILE, size);
+
+  // Directory scans and sorting over a fuller directory
+  char name[13];
+  for (uint8_t i = 0; i < BENCH_DIR_FILES; ++i) {
+    sprintf_P(name, PSTR("BENCH%02u.GCO"), i);
+    bench_write(name, 512);
+  }
+  bench_start();
+  const int16_t items = card.get_num_items();
+  bench_report(F("directory scan"));
+  SERIAL_ECHOLNPGM("SD benchmark: ", items, " items");
+
+  #if ENABLED(SDCARD_SORT_ALPHA)
+    bench_start();
+    card.presort();
+    bench_report(F("presort"));
+  #endif
+
+  // Clean up
+  for (uint8_t i = 0; i < BENCH_DIR_FILES; ++i) {
+    sprintf_P(name, PSTR("BENCH%02u.GCO"), i);
+    card.removeFile(name);
+  }
+  card.removeFile(BENCH_FILE);
+  card.cdroot();
+}
+
+#endif // MARLIN_TEST_BUILD && NEED_SD2CARD_FILE
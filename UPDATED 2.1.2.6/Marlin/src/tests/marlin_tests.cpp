@@ -31,12 +31,37 @@
 #include "../module/stepper.h"
 #include "../module/temperature.h"
 
+#if ENABLED(IK_EXTRAPOLATION)
+  #include "../module/ik_extrapolation.h"
+#endif
+
+#if ENABLED(SHAPING_AUTOTUNE)
+  #include "../feature/resonance_test.h"
+#endif
+
+#if ENABLED(SD_IMAGE_DRIVER)
+  #include "../sd/sd_benchmark.h"
+#endif
+
+#if ENABLED(LSF_ROBUST_FIT)
+  #include "../libs/least_squares_fit.h"
+#endif
+
+#if ENABLED(SD_JOB_ESTIMATE)
+  #include "../feature/job_estimate.h"
+#endif
+
 // Individual tests are localized in each module.
 // Each test produces its own report.
 
 // Startup tests are run at the end of setup()
 void runStartupTests() {
   // Call post-setup tests here to validate behaviors.
+  TERN_(IK_EXTRAPOLATION, ik_extrapolation.test());
+  TERN_(SHAPING_AUTOTUNE, resonance_test.test());
+  TERN_(SD_IMAGE_DRIVER, sd_benchmark());
+  TERN_(LSF_ROBUST_FIT, test_robust_LSF());
+  TERN_(SD_JOB_ESTIMATE, job_estimate.test());
 }
 
 // Periodic tests are run from within loop()
@@ -0,0 +1,163 @@
+#!/usr/bin/env python3
+#
+# telemetry_decode.py
+#
+# Decode the binary motion telemetry sent by Marlin after 'M577 S1'
+# (Requires MOTION_TELEMETRY). The frames are mixed in with the usual
+# text replies, so the text is skipped and only frames with a good CRC
+# are decoded.
+#
+# Frame: 0xA5 0x5A <type> <length> <payload> <crc16-lo> <crc16-hi>
+#
+# Usage:
+#   telemetry_decode.py capture.bin [--rate 2000000] [--csv out.csv]
+#   telemetry_decode.py /dev/ttyUSB0 --baud 250000 [--seconds 60]
+#
+# When reading a serial port the script sends 'M577 S1' and prints a
+# summary when the time runs out or on Ctrl-C. (Requires pyserial)
+#
+
+import argparse, struct, sys, time
+
+SYNC = b'\xA5\x5A'
+
+FORMATS = {
+  ord('S'): ('block_start', '<IBIIII', ('ticks', 'fill', 'initial_rate', 'nominal_rate', 'final_rate', 'steps')),
+  ord('E'): ('block_end',   '<IHH',    ('ticks', 'overruns', 'loop_limits')),
+  ord('U'): ('starved',     '<I',      ('ticks',)),
+  ord('P'): ('slowdown',    '<IBHIB',  ('ticks', 'fill', 'queued_ms', 'feed_interval_us', 'percent')),
+  ord('D'): ('dropped',     '<H',      ('count',)),
+}
+
+def crc16(data, crc=0):
+  # CRC-16/XMODEM, as in Marlin's libs/crc16.cpp
+  for b in data:
+    crc ^= b << 8
+    for _ in range(8):
+      crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+      crc &= 0xFFFF
+  return crc
+
+class Decoder:
+  def __init__(self):
+    self.buf = bytearray()
+    self.bad_crc = 0
+
+  def feed(self, data):
+    """ Add bytes and return the list of (name, fields) for complete frames """
+    self.buf += data
+    events = []
+    while True:
+      i = self.buf.find(SYNC)
+      if i < 0:
+        del self.buf[:-1]   # Keep a trailing 0xA5
+        break
+      del self.buf[:i]
+      if len(self.buf) < 4: break
+      ftype, length = self.buf[2], self.buf[3]
+      if len(self.buf) < 6 + length: break
+      frame = bytes(self.buf[2:4 + length])
+      crc = self.buf[4 + length] | (self.buf[5 + length] << 8)
+      fmt = FORMATS.get(ftype)
+      if crc != crc16(frame) or not fmt or struct.calcsize(fmt[1]) != length:
+        self.bad_crc += 1
+        del self.buf[:1]    # Not a frame. Look for the next sync.
+        continue
+      del self.buf[:6 + length]
+      events.append((fmt[0], dict(zip(fmt[2], struct.unpack(fmt[1], frame[2:])))))
+    return events
+
+class Summary:
+  def __init__(self, rate, low_fill):
+    self.rate = rate
+    self.low_fill = low_fill
+    self.blocks = self.starved = self.low = self.dropped = self.slowed = 0
+    self.slowest = 100
+    self.overruns = self.loop_limits = 0
+    self.stall = 0.0
+    self.last_end = None
+    self.base = None
+
+  def seconds(self, ticks):
+    if self.base is None: self.base = ticks
+    return ((ticks - self.base) & 0xFFFFFFFF) / self.rate
+
+  def add(self, name, f):
+    if name == 'dropped':
+      self.dropped += f['count']
+      return None
+    t = self.seconds(f['ticks'])
+    if name == 'block_start':
+      self.blocks += 1
+      if f['fill'] <= self.low_fill: self.low += 1
+      if self.last_end is not None: self.stall = max(self.stall, t - self.last_end)
+      self.last_end = None
+    elif name == 'block_end':
+      self.overruns, self.loop_limits = f['overruns'], f['loop_limits']
+      self.last_end = t
+    elif name == 'starved':
+      self.starved += 1
+    elif name == 'slowdown':
+      self.slowed += 1
+      self.slowest = min(self.slowest, f['percent'])
+    return t
+
+  def report(self):
+    print('Blocks:        %d' % self.blocks)
+    print('Starved:       %d' % self.starved)
+    print('Slowed:        %d (slowest %d%%)' % (self.slowed, self.slowest))
+    print('Low fill (<=%d): %d' % (self.low_fill, self.low))
+    print('Longest gap:   %.1f ms' % (self.stall * 1000))
+    print('ISR overruns:  %d' % self.overruns)
+    print('Loop limits:   %d' % self.loop_limits)
+    print('Dropped:       %d' % self.dropped)
+
+def main():
+  ap = argparse.ArgumentParser(description='Decode Marlin M577 motion telemetry')
+  ap.add_argument('source', help='Capture file or serial port')
+  ap.add_argument('--baud', type=int, default=250000, help='Serial baud rate')
+  ap.add_argument('--seconds', type=float, default=0, help='Stop reading the serial port after this time')
+  ap.add_argument('--rate', type=float, default=2000000, help='STEPPER_TIMER_RATE of the board (ticks/s)')
+  ap.add_argument('--low-fill', type=int, default=2, help='Count blocks started with this many or fewer planned')
+  ap.add_argument('--csv', help='Write every event to this CSV file')
+  ap.add_argument('--quiet', action='store_true', help='Only print the summary')
+  args = ap.parse_args()
+
+  dec, summary = Decoder(), Summary(args.rate, args.low_fill)
+  csv = open(args.csv, 'w') if args.csv else None
+  columns = ('fill', 'initial_rate', 'nominal_rate', 'final_rate', 'steps', 'overruns', 'loop_limits',
+             'queued_ms', 'feed_interval_us', 'percent', 'count')
+  if csv: csv.write('time,event,' + ','.join(columns) + '\n')
+
+  def handle(events):
+    for name, f in events:
+      t = summary.add(name, f)
+      if not args.quiet:
+        print('%10s %-12s %s' % ('' if t is None else '%.4f' % t, name, ' '.join('%s=%d' % kv for kv in f.items() if kv[0] != 'ticks')))
+      if csv:
+        csv.write(','.join(['' if t is None else '%.6f' % t, name] + [str(f.get(k, '')) for k in columns]) + '\n')
+
+  try:
+    if args.source.startswith('/dev/') or args.source.upper().startswith('COM'):
+      import serial
+      port = serial.Serial(args.source, args.baud, timeout=0.1)
+      port.write(b'M577 S1\n')
+      end = time.time() + args.seconds if args.seconds else None
+      try:
+        while end is None or time.time() < end:
+          handle(dec.feed(port.read(4096)))
+      finally:
+        port.write(b'M577 S0\n')
+        port.close()
+    else:
+      with open(args.source, 'rb') as f:
+        handle(dec.feed(f.read()))
+  except KeyboardInterrupt:
+    pass
+
+  if csv: csv.close()
+  summary.report()
+  if dec.bad_crc: print('Bad frames:    %d' % dec.bad_crc)
+
+if __name__ == '__main__':
+  main()